@@ -316,6 +316,27 @@ void AdsServiceImpl::OnPrefChanged(const std::string& path) {
   bat_ads_->OnPrefChanged(path);
 }
 
+bool AdsServiceImpl::ShouldExtractConversionId(
+    const std::vector<GURL>& redirect_chain) const {
+  if (!bat_ads_.is_bound()) {
+    return false;
+  }
+
+  if (!conversion_url_patterns_) {
+    return true;
+  }
+
+  for (const auto& url_pattern : *conversion_url_patterns_) {
+    for (const auto& url : redirect_chain) {
+      if (ads::DoesUrlMatchConversionUrlPattern(url.spec(), url_pattern)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 void AdsServiceImpl::OnHtmlLoaded(const SessionID& tab_id,
                                   const std::vector<GURL>& redirect_chain,
                                   const std::string& html) {
@@ -563,6 +584,8 @@ void AdsServiceImpl::Shutdown() {
 
   url_loaders_.clear();
 
+  conversion_url_patterns_.reset();
+
   idle_poll_timer_.Stop();
 
   bat_ads_.reset();
@@ -2311,6 +2334,11 @@ void AdsServiceImpl::OnAdRewardsChanged() {
   }
 }
 
+void AdsServiceImpl::OnConversionUrlPatternsChanged(
+    const std::vector<std::string>& url_patterns) {
+  conversion_url_patterns_ = url_patterns;
+}
+
 void AdsServiceImpl::WriteDiagnosticLog(const std::string& file,
                                         const int line,
                                         const int verbose_level,
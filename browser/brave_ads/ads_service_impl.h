@@ -36,6 +36,7 @@
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "ui/base/idle/idle.h"
 
 #if BUILDFLAG(BRAVE_ADAPTIVE_CAPTCHA_ENABLED)
@@ -135,6 +136,9 @@ class AdsServiceImpl : public AdsService,
 
   void OnPrefChanged(const std::string& path);
 
+  bool ShouldExtractConversionId(
+      const std::vector<GURL>& redirect_chain) const override;
+
   void OnHtmlLoaded(const SessionID& tab_id,
                     const std::vector<GURL>& redirect_chain,
                     const std::string& html) override;
@@ -423,6 +427,9 @@ class AdsServiceImpl : public AdsService,
 
   void OnAdRewardsChanged() override;
 
+  void OnConversionUrlPatternsChanged(
+      const std::vector<std::string>& url_patterns) override;
+
   void RecordP2AEvent(const std::string& name,
                       const ads::mojom::P2AEventType type,
                       const std::string& value) override;
@@ -486,6 +493,11 @@ class AdsServiceImpl : public AdsService,
 
   bool is_initialized_ = false;
 
+  // Patterns of the URLs whose HTML conversions are waiting on. Unset until
+  // the ads library has published them, in which case every page is
+  // serialized so that no conversion id is missed.
+  absl::optional<std::vector<std::string>> conversion_url_patterns_;
+
   bool deprecated_data_files_removed_ = false;
 
   bool is_upgrading_from_pre_brave_ads_build_;
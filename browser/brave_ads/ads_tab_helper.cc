@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/strings/stringprintf.h"
 #include "brave/browser/brave_ads/ads_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
@@ -27,6 +28,23 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Text classification saturates long before this, and it keeps the text sent
+// to the ads service process to kilobytes for even the largest pages.
+constexpr int kMaxTextLength = 32 * 1024;
+
+// Conversion id patterns are regular expressions over the serialized
+// document, so pages a conversion is waiting on are serialized whole.
+constexpr char kPageContentScript[] = R"(
+  (function() {
+    const text = (document.body?.innerText ?? '').replace(/\s+/g, ' ');
+    const html = %s ? new XMLSerializer().serializeToString(document) : '';
+    return {html: html, text: text.trim().substring(0, %d)};
+  })())";
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       content::WebContentsUserData<AdsTabHelper>(*web_contents),
@@ -62,43 +80,44 @@ void AdsTabHelper::TabUpdated() {
                              is_active_, is_browser_active_);
 }
 
+// static
+std::string AdsTabHelper::GetPageContentScript(bool serialize_html) {
+  return base::StringPrintf(kPageContentScript,
+                            serialize_html ? "true" : "false", kMaxTextLength);
+}
+
+void AdsTabHelper::SetAdsServiceForTesting(AdsService* ads_service) {
+  ads_service_ = ads_service;
+}
+
 void AdsTabHelper::RunIsolatedJavaScript(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
+  const bool serialize_html =
+      ads_service_ && ads_service_->ShouldExtractConversionId(redirect_chain_);
   dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "new XMLSerializer().serializeToString(document)",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
-                     weak_factory_.GetWeakPtr()));
-
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document?.body?.innerText",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptTextResult,
+      render_frame_host, GetPageContentScript(serialize_html),
+      base::BindOnce(&AdsTabHelper::OnJavaScriptResult,
                      weak_factory_.GetWeakPtr()));
 }
 
-void AdsTabHelper::OnJavaScriptHtmlResult(base::Value value) {
+void AdsTabHelper::OnJavaScriptResult(base::Value value) {
   if (!ads_service_) {
     return;
   }
 
-  if (!value.is_string()) {
+  if (!value.is_dict()) {
     return;
   }
-  const std::string& html = value.GetString();
-  ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, html);
-}
 
-void AdsTabHelper::OnJavaScriptTextResult(base::Value value) {
-  if (!ads_service_) {
-    return;
+  if (const std::string* html = value.FindStringKey("html")) {
+    ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, *html);
   }
 
-  if (!value.is_string()) {
-    return;
+  if (const std::string* text = value.FindStringKey("text")) {
+    ads_service_->OnTextLoaded(tab_id_, redirect_chain_, *text);
   }
-  const std::string& text = value.GetString();
-  ads_service_->OnTextLoaded(tab_id_, redirect_chain_, text);
 }
 
 void AdsTabHelper::DidFinishNavigation(
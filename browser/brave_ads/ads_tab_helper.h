@@ -52,6 +52,14 @@ class AdsTabHelper : public content::WebContentsObserver,
   AdsTabHelper(const AdsTabHelper&) = delete;
   AdsTabHelper& operator=(const AdsTabHelper&) = delete;
 
+  // Returns the script run in an isolated world once a page has loaded. It
+  // evaluates to a dictionary with the page "text", whitespace collapsed and
+  // truncated, and the page "html" if |serialize_html| is true, which is only
+  // the case for pages a conversion is waiting on.
+  static std::string GetPageContentScript(bool serialize_html);
+
+  void SetAdsServiceForTesting(AdsService* ads_service);
+
  private:
   friend class content::WebContentsUserData<AdsTabHelper>;
 
@@ -59,9 +67,7 @@ class AdsTabHelper : public content::WebContentsObserver,
 
   void RunIsolatedJavaScript(content::RenderFrameHost* render_frame_host);
 
-  void OnJavaScriptHtmlResult(base::Value value);
-
-  void OnJavaScriptTextResult(base::Value value);
+  void OnJavaScriptResult(base::Value value);
 
   // content::WebContentsObserver overrides
   void DidFinishNavigation(
@@ -0,0 +1,374 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_ads/ads_tab_helper.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
+#include "base/values.h"
+#include "brave/components/brave_adaptive_captcha/buildflags/buildflags.h"
+#include "brave/components/brave_ads/browser/ads_service.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/common/chrome_isolated_world_ids.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_browser_tests --filter=AdsTabHelperBrowserTest.*
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace brave_ads {
+
+namespace {
+
+class MockAdsService : public AdsService {
+ public:
+  MockAdsService() = default;
+  ~MockAdsService() override = default;
+
+  MOCK_METHOD(bool, IsSupportedLocale, (), (const, override));
+  MOCK_METHOD(bool, IsEnabled, (), (const, override));
+  MOCK_METHOD(void, SetEnabled, (const bool), (override));
+  MOCK_METHOD(void, SetAllowConversionTracking, (const bool), (override));
+  MOCK_METHOD(int64_t, GetAdsPerHour, (), (const, override));
+  MOCK_METHOD(void, SetAdsPerHour, (const int64_t), (override));
+  MOCK_METHOD(bool, ShouldAllowAdsSubdivisionTargeting, (), (const, override));
+  MOCK_METHOD(std::string,
+              GetAdsSubdivisionTargetingCode,
+              (),
+              (const, override));
+  MOCK_METHOD(void,
+              SetAdsSubdivisionTargetingCode,
+              (const std::string&),
+              (override));
+  MOCK_METHOD(std::string,
+              GetAutoDetectedAdsSubdivisionTargetingCode,
+              (),
+              (const, override));
+  MOCK_METHOD(void,
+              SetAutoDetectedAdsSubdivisionTargetingCode,
+              (const std::string&),
+              (override));
+#if BUILDFLAG(BRAVE_ADAPTIVE_CAPTCHA_ENABLED)
+  MOCK_METHOD(void,
+              ShowScheduledCaptcha,
+              (const std::string&, const std::string&),
+              (override));
+  MOCK_METHOD(void, SnoozeScheduledCaptcha, (), (override));
+#endif
+  MOCK_METHOD(void, OnShowAdNotification, (const std::string&), (override));
+  MOCK_METHOD(void,
+              OnCloseAdNotification,
+              (const std::string&, const bool),
+              (override));
+  MOCK_METHOD(void, OnClickAdNotification, (const std::string&), (override));
+  MOCK_METHOD(void, ChangeLocale, (const std::string&), (override));
+  MOCK_METHOD(bool,
+              ShouldExtractConversionId,
+              (const std::vector<GURL>&),
+              (const, override));
+  MOCK_METHOD(void,
+              OnHtmlLoaded,
+              (const SessionID&, const std::vector<GURL>&, const std::string&),
+              (override));
+  MOCK_METHOD(void,
+              OnTextLoaded,
+              (const SessionID&, const std::vector<GURL>&, const std::string&),
+              (override));
+  MOCK_METHOD(void, OnUserGesture, (const int32_t), (override));
+  MOCK_METHOD(void, OnMediaStart, (const SessionID&), (override));
+  MOCK_METHOD(void, OnMediaStop, (const SessionID&), (override));
+  MOCK_METHOD(void,
+              OnTabUpdated,
+              (const SessionID&, const GURL&, const bool, const bool),
+              (override));
+  MOCK_METHOD(void, OnTabClosed, (const SessionID&), (override));
+  MOCK_METHOD(void,
+              OnResourceComponentUpdated,
+              (const std::string&),
+              (override));
+  MOCK_METHOD(void,
+              OnNewTabPageAdEvent,
+              (const std::string&,
+               const std::string&,
+               const ads::mojom::NewTabPageAdEventType),
+              (override));
+  MOCK_METHOD(void,
+              OnPromotedContentAdEvent,
+              (const std::string&,
+               const std::string&,
+               const ads::mojom::PromotedContentAdEventType),
+              (override));
+  MOCK_METHOD(void,
+              GetInlineContentAd,
+              (const std::string&, OnGetInlineContentAdCallback),
+              (override));
+  MOCK_METHOD(void,
+              OnInlineContentAdEvent,
+              (const std::string&,
+               const std::string&,
+               const ads::mojom::InlineContentAdEventType),
+              (override));
+  MOCK_METHOD(void,
+              PurgeOrphanedAdEventsForType,
+              (const ads::mojom::AdType),
+              (override));
+  MOCK_METHOD(void,
+              GetHistory,
+              (const double, const double, OnGetHistoryCallback),
+              (override));
+  MOCK_METHOD(void,
+              GetStatementOfAccounts,
+              (GetStatementOfAccountsCallback),
+              (override));
+  MOCK_METHOD(void, GetAdDiagnostics, (GetAdDiagnosticsCallback), (override));
+  MOCK_METHOD(void,
+              ToggleAdThumbUp,
+              (const std::string&, OnToggleAdThumbUpCallback),
+              (override));
+  MOCK_METHOD(void,
+              ToggleAdThumbDown,
+              (const std::string&, OnToggleAdThumbDownCallback),
+              (override));
+  MOCK_METHOD(void,
+              ToggleAdOptIn,
+              (const std::string&, const int, OnToggleAdOptInCallback),
+              (override));
+  MOCK_METHOD(void,
+              ToggleAdOptOut,
+              (const std::string&, const int, OnToggleAdOptOutCallback),
+              (override));
+  MOCK_METHOD(void,
+              ToggleSavedAd,
+              (const std::string&, OnToggleSavedAdCallback),
+              (override));
+  MOCK_METHOD(void,
+              ToggleFlaggedAd,
+              (const std::string&, OnToggleFlaggedAdCallback),
+              (override));
+  MOCK_METHOD(void, ResetAllState, (const bool), (override));
+};
+
+// What the tab helper used to run, serializing the whole document.
+constexpr char kSerializeDocumentScript[] =
+    "new XMLSerializer().serializeToString(document)";
+constexpr char kInnerTextScript[] = "document?.body?.innerText";
+
+// A news article with large inline scripts and styles, as heavy pages have.
+std::string GetPage(int paragraph_count) {
+  std::string page =
+      "<html><head>"
+      "<meta charset=\"utf-8\">"
+      "<meta name=\"ad-conversion-id\" content=\"abc-123\">"
+      "<style>";
+  for (int i = 0; i < paragraph_count; ++i)
+    page += base::StringPrintf(".c%d { margin: %dpx; }\n", i, i % 10);
+  page += "</style><script>var data = [";
+  for (int i = 0; i < paragraph_count; ++i)
+    page += base::StringPrintf("{\"id\": %d, \"tracking\": \"%08d\"},", i, i);
+  page += "];</script></head><body>";
+  for (int i = 0; i < paragraph_count; ++i) {
+    page += base::StringPrintf(
+        "<div class=\"c%d\"><p>Paragraph %d about   the latest\n\tsports "
+        "cars, travel deals and personal finance.</p></div>",
+        i, i);
+  }
+  return page + "</body></html>";
+}
+
+std::unique_ptr<net::test_server::HttpResponse> HandleRequest(
+    const net::test_server::HttpRequest& request) {
+  int paragraph_count = 0;
+  if (request.relative_url == "/small.html") {
+    paragraph_count = 3;
+  } else if (request.relative_url == "/heavy.html") {
+    paragraph_count = 20000;
+  } else {
+    return nullptr;
+  }
+
+  auto http_response = std::make_unique<net::test_server::BasicHttpResponse>();
+  http_response->set_code(net::HTTP_OK);
+  http_response->set_content_type("text/html");
+  http_response->set_content(GetPage(paragraph_count));
+  return http_response;
+}
+
+std::string GetStringValue(const base::Value& value) {
+  return value.is_string() ? value.GetString() : std::string();
+}
+
+}  // namespace
+
+class AdsTabHelperBrowserTest : public InProcessBrowserTest {
+ public:
+  AdsTabHelperBrowserTest() = default;
+  ~AdsTabHelperBrowserTest() override = default;
+
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+    embedded_test_server()->RegisterRequestHandler(
+        base::BindRepeating(&HandleRequest));
+    ASSERT_TRUE(embedded_test_server()->Start());
+  }
+
+  content::WebContents* web_contents() {
+    return browser()->tab_strip_model()->GetActiveWebContents();
+  }
+
+  base::Value RunIsolatedJavaScript(const std::string& script) {
+    return content::EvalJs(web_contents(), script,
+                           content::EXECUTE_SCRIPT_DEFAULT_OPTIONS,
+                           ISOLATED_WORLD_ID_CHROME_INTERNAL)
+        .ExtractValue()
+        .Clone();
+  }
+
+  // Routes the tab helper's calls to |ads_service_mock_|, which is asked
+  // whether to serialize the next page loaded.
+  void SetShouldExtractConversionId(bool should_extract_conversion_id) {
+    AdsTabHelper::FromWebContents(web_contents())
+        ->SetAdsServiceForTesting(&ads_service_mock_);
+    ON_CALL(ads_service_mock_, ShouldExtractConversionId(_))
+        .WillByDefault(Return(should_extract_conversion_id));
+  }
+
+  // Loads |path| and returns the html the tab helper sends to the ads
+  // service for it.
+  std::string LoadPageAndGetHtml(const std::string& path) {
+    std::string loaded_html;
+    base::RunLoop run_loop;
+    EXPECT_CALL(ads_service_mock_, OnHtmlLoaded(_, _, _))
+        .WillOnce([&](const SessionID&, const std::vector<GURL>&,
+                      const std::string& html) {
+          loaded_html = html;
+          run_loop.Quit();
+        });
+    EXPECT_TRUE(ui_test_utils::NavigateToURL(
+        browser(), embedded_test_server()->GetURL(path)));
+    run_loop.Run();
+    return loaded_html;
+  }
+
+  // Returns the renderer main thread time spent running |script|.
+  double GetScriptTime(const std::string& script) {
+    return RunIsolatedJavaScript(
+               "(() => { const start = performance.now(); const result = " +
+               script + "; return performance.now() - start; })()")
+        .GetDouble();
+  }
+
+  NiceMock<MockAdsService> ads_service_mock_;
+};
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, PageContent) {
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(
+      browser(), embedded_test_server()->GetURL("/small.html")));
+
+  base::Value content = RunIsolatedJavaScript(
+      AdsTabHelper::GetPageContentScript(/*serialize_html=*/false));
+  ASSERT_TRUE(content.is_dict());
+  const std::string* text = content.FindStringKey("text");
+  ASSERT_TRUE(text);
+  EXPECT_EQ(*text,
+            "Paragraph 0 about the latest sports cars, travel deals and "
+            "personal finance. Paragraph 1 about the latest sports cars, "
+            "travel deals and personal finance. Paragraph 2 about the latest "
+            "sports cars, travel deals and personal finance.");
+  const std::string* html = content.FindStringKey("html");
+  ASSERT_TRUE(html);
+  EXPECT_TRUE(html->empty());
+}
+
+// Pages a conversion is waiting on are serialized for the conversion id.
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, ConversionPageContent) {
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(
+      browser(), embedded_test_server()->GetURL("/small.html")));
+
+  base::Value content = RunIsolatedJavaScript(
+      AdsTabHelper::GetPageContentScript(/*serialize_html=*/true));
+  ASSERT_TRUE(content.is_dict());
+  const std::string* html = content.FindStringKey("html");
+  ASSERT_TRUE(html);
+  EXPECT_EQ(*html, GetStringValue(RunIsolatedJavaScript(
+                       kSerializeDocumentScript)));
+  EXPECT_NE(html->find("name=\"ad-conversion-id\" content=\"abc-123\""),
+            std::string::npos);
+}
+
+// A page that matches none of the conversion URL patterns sends no html to
+// the ads service, only its text.
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, NonConversionPageSendsNoHtml) {
+  SetShouldExtractConversionId(false);
+  EXPECT_CALL(ads_service_mock_, OnTextLoaded(_, _, _));
+
+  EXPECT_TRUE(LoadPageAndGetHtml("/small.html").empty());
+}
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, ConversionPageSendsHtml) {
+  SetShouldExtractConversionId(true);
+
+  const std::string html = LoadPageAndGetHtml("/small.html");
+  EXPECT_NE(html.find("name=\"ad-conversion-id\" content=\"abc-123\""),
+            std::string::npos);
+}
+
+// Compares the renderer time and the bytes sent to the browser, and held
+// there until they reach the ads service, for a page of a few MB.
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, HeavyPage) {
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(
+      browser(), embedded_test_server()->GetURL("/heavy.html")));
+
+  base::ElapsedTimer serialized_timer;
+  const size_t serialized_bytes =
+      GetStringValue(RunIsolatedJavaScript(kSerializeDocumentScript)).size() +
+      GetStringValue(RunIsolatedJavaScript(kInnerTextScript)).size();
+  const base::TimeDelta serialized_time = serialized_timer.Elapsed();
+  const double serialized_renderer_time =
+      GetScriptTime(kSerializeDocumentScript) + GetScriptTime(kInnerTextScript);
+
+  base::ElapsedTimer extracted_timer;
+  base::Value content = RunIsolatedJavaScript(
+      AdsTabHelper::GetPageContentScript(/*serialize_html=*/false));
+  const base::TimeDelta extracted_time = extracted_timer.Elapsed();
+  ASSERT_TRUE(content.is_dict());
+  const std::string* text = content.FindStringKey("text");
+  const std::string* html = content.FindStringKey("html");
+  ASSERT_TRUE(text && html);
+  const size_t extracted_bytes = text->size() + html->size();
+  const double extracted_renderer_time = GetScriptTime(
+      AdsTabHelper::GetPageContentScript(/*serialize_html=*/false));
+
+  VLOG(1) << "Serialized document and text: " << serialized_bytes
+          << " bytes in " << serialized_time << ", "
+          << serialized_renderer_time << " ms on the renderer main thread; "
+          << "extracted content: " << extracted_bytes << " bytes in "
+          << extracted_time << ", " << extracted_renderer_time
+          << " ms on the renderer main thread";
+
+  EXPECT_GT(serialized_bytes, 2u * 1024 * 1024);
+  EXPECT_LE(extracted_bytes, 32u * 1024);
+  EXPECT_TRUE(html->empty());
+}
+
+}  // namespace brave_ads
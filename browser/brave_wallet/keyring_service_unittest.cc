@@ -13,6 +13,8 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/bind.h"
 #include "base/test/scoped_feature_list.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/time_override.h"
 #include "brave/browser/brave_wallet/json_rpc_service_factory.h"
 #include "brave/components/bls/buildflags.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
@@ -1210,6 +1212,101 @@ TEST_F(KeyringServiceUnitTest, LockAndUnlock) {
   }
 }
 
+TEST_F(KeyringServiceUnitTest, UnlockDerivesKeysOffUISequence) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitWithFeatures(
+      {brave_wallet::features::kBraveWalletFilecoinFeature,
+       brave_wallet::features::kBraveWalletSolanaFeature},
+      {});
+  KeyringService service(json_rpc_service(), GetPrefs());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  ASSERT_TRUE(AddAccount(&service, "FIL Account 1", mojom::CoinType::FIL));
+  ASSERT_TRUE(AddAccount(&service, "SOL Account 1", mojom::CoinType::SOL));
+  service.Lock();
+
+  // Time is mocked by the fixture, unlock latency is measured in real time.
+  const base::TimeTicks start = base::subtle::TimeTicksNowIgnoringOverride();
+  bool unlocked = false;
+  bool ui_task_ran = false;
+  base::RunLoop run_loop;
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   unlocked = success;
+                   run_loop.Quit();
+                 }));
+  const base::TimeDelta ui_blocked =
+      base::subtle::TimeTicksNowIgnoringOverride() - start;
+  // Keys are derived on the thread pool, Unlock returns right away and the
+  // UI sequence keeps running tasks until the reply arrives.
+  EXPECT_FALSE(unlocked);
+  EXPECT_TRUE(service.IsLocked());
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindLambdaForTesting([&]() {
+        EXPECT_FALSE(unlocked);
+        ui_task_ran = true;
+      }));
+  run_loop.Run();
+  const base::TimeDelta unlock_latency =
+      base::subtle::TimeTicksNowIgnoringOverride() - start;
+  EXPECT_TRUE(ui_task_ran);
+  EXPECT_TRUE(unlocked);
+  EXPECT_FALSE(service.IsLocked());
+  EXPECT_FALSE(service.IsLocked(mojom::kFilecoinKeyringId));
+  EXPECT_FALSE(service.IsLocked(mojom::kSolanaKeyringId));
+  VLOG(1) << "UI sequence blocked for " << ui_blocked << ", unlocked after "
+          << unlock_latency;
+
+  // Keyrings sharing a salt share one derivation.
+  const std::vector<uint8_t> salt(32, 0x01);
+  const std::vector<uint8_t> salt2(32, 0x02);
+  auto keys = KeyringService::DeriveKeysFromPassword("brave",
+                                                     {salt, salt2, salt});
+  EXPECT_EQ(keys.size(), 2u);
+  EXPECT_TRUE(keys[salt]);
+  EXPECT_TRUE(keys[salt2]);
+}
+
+TEST_F(KeyringServiceUnitTest, LockOrResetWhileUnlocking) {
+  KeyringService service(json_rpc_service(), GetPrefs());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  service.Lock();
+
+  // Locking while the keys are derived keeps the wallet locked.
+  bool unlock_called = false;
+  base::RunLoop run_loop;
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   EXPECT_FALSE(success);
+                   unlock_called = true;
+                   run_loop.Quit();
+                 }));
+  service.Lock();
+  run_loop.Run();
+  EXPECT_TRUE(unlock_called);
+  EXPECT_TRUE(service.IsLocked());
+
+  // So does resetting the wallet.
+  unlock_called = false;
+  bool validate_called = false;
+  base::RunLoop run_loop2;
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   EXPECT_FALSE(success);
+                   unlock_called = true;
+                   if (validate_called)
+                     run_loop2.Quit();
+                 }));
+  service.ValidatePassword("brave",
+                           base::BindLambdaForTesting([&](bool result) {
+                             EXPECT_FALSE(result);
+                             validate_called = true;
+                             if (unlock_called)
+                               run_loop2.Quit();
+                           }));
+  service.Reset();
+  run_loop2.Run();
+  EXPECT_TRUE(unlock_called);
+  EXPECT_TRUE(validate_called);
+  EXPECT_TRUE(service.IsLocked());
+}
+
 TEST_F(KeyringServiceUnitTest, Reset) {
   KeyringService service(json_rpc_service(), GetPrefs());
   ASSERT_TRUE(CreateWallet(&service, "brave"));
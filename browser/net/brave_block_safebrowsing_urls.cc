@@ -7,6 +7,8 @@
 
 #include <vector>
 
+#include "base/no_destructor.h"
+#include "brave/browser/net/host_indexed_url_matcher.h"
 #include "extensions/common/url_pattern.h"
 #include "net/base/net_errors.h"
 #include "url/gurl.h"
@@ -15,34 +17,41 @@ namespace brave {
 
 const char kDummyUrl[] = "https://no-thanks.invalid";
 
+namespace {
+
+enum SafeBrowsingRule {
+  kAllowedRule,
+  kReportingRule,
+};
+
+}  // namespace
+
 bool IsSafeBrowsingReportingURL(const GURL& gurl) {
-  static const std::vector<URLPattern> allowed_patterns({
-      URLPattern(
-          URLPattern::SCHEME_HTTPS,
-          "https://sb-ssl.google.com/safebrowsing/clientreport/download*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://safebrowsing.google.com/safebrowsing/clientreport/"
-                 "crx-list-info*"),
-  });
-  static const std::vector<URLPattern> reporting_patterns({
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://sb-ssl.google.com/safebrowsing/clientreport/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://safebrowsing.google.com/safebrowsing/clientreport/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://safebrowsing.google.com/safebrowsing/report*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://safebrowsing.google.com/safebrowsing/uploads/*"),
-  });
-
-  if (std::any_of(
-          allowed_patterns.begin(), allowed_patterns.end(),
-          [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); })) {
-    return false;
-  }
-  return std::any_of(
-      reporting_patterns.begin(), reporting_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+  // Allowed URLs come first as they are exceptions to the reporting ones.
+  static const base::NoDestructor<HostIndexedURLMatcher> matcher(
+      std::vector<HostIndexedURLMatcher::Rule>({
+          {URLPattern::SCHEME_HTTPS,
+           "https://sb-ssl.google.com/safebrowsing/clientreport/download*",
+           kAllowedRule},
+          {URLPattern::SCHEME_HTTPS,
+           "https://safebrowsing.google.com/safebrowsing/clientreport/"
+           "crx-list-info*",
+           kAllowedRule},
+          {URLPattern::SCHEME_HTTPS,
+           "https://sb-ssl.google.com/safebrowsing/clientreport/*",
+           kReportingRule},
+          {URLPattern::SCHEME_HTTPS,
+           "https://safebrowsing.google.com/safebrowsing/clientreport/*",
+           kReportingRule},
+          {URLPattern::SCHEME_HTTPS,
+           "https://safebrowsing.google.com/safebrowsing/report*",
+           kReportingRule},
+          {URLPattern::SCHEME_HTTPS,
+           "https://safebrowsing.google.com/safebrowsing/uploads/*",
+           kReportingRule},
+      }));
+
+  return matcher->Match(gurl) == kReportingRule;
 }
 
 int OnBeforeURLRequest_BlockSafeBrowsingReportingURLs(const GURL& request_url,
@@ -7,9 +7,13 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/no_destructor.h"
+#include "base/notreached.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "brave/browser/net/host_indexed_url_matcher.h"
 #include "brave/common/network_constants.h"
 #include "extensions/common/url_pattern.h"
 #include "net/base/net_errors.h"
@@ -42,6 +46,25 @@ bool RewriteBugReportingURL(const GURL& request_url, GURL* new_url) {
   return true;
 }
 
+enum CommonStaticRedirectRule {
+  kChromeCastRule,
+  kClients4Rule,
+  kBugReportingRule,
+};
+
+const HostIndexedURLMatcher& GetCommonStaticRedirectMatcher() {
+  constexpr int kHttpOrHttps =
+      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+  static const base::NoDestructor<HostIndexedURLMatcher> matcher(
+      std::vector<HostIndexedURLMatcher::Rule>({
+          {kHttpOrHttps, kChromeCastPrefix, kChromeCastRule},
+          {kHttpOrHttps, kClients4Prefix, kClients4Rule, true},
+          {kHttpOrHttps, "*://bugs.chromium.org/p/chromium/issues/entry?*",
+           kBugReportingRule},
+      }));
+  return *matcher;
+}
+
 }  // namespace
 
 int OnBeforeURLRequest_CommonStaticRedirectWork(
@@ -61,36 +84,30 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
     GURL* new_url) {
   DCHECK(new_url);
 
-  GURL::Replacements replacements;
-  static URLPattern chromecast_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kChromeCastPrefix);
-  static URLPattern clients4_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kClients4Prefix);
-  static URLPattern bugsChromium_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://bugs.chromium.org/p/chromium/issues/entry?*");
-
-  if (chromecast_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
+  absl::optional<int> rule =
+      GetCommonStaticRedirectMatcher().Match(request_url);
+  if (!rule)
     return net::OK;
-  }
 
-  if (clients4_pattern.MatchesHost(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveClients4Proxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (bugsChromium_pattern.MatchesURL(request_url)) {
-    if (RewriteBugReportingURL(request_url, new_url))
-      return net::OK;
+  GURL::Replacements replacements;
+  switch (*rule) {
+    case kChromeCastRule:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveRedirectorProxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      break;
+    case kClients4Rule:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveClients4Proxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      break;
+    case kBugReportingRule:
+      RewriteBugReportingURL(request_url, new_url);
+      break;
+    default:
+      NOTREACHED();
   }
-
   return net::OK;
 }
 
-
 }  // namespace brave
@@ -5,11 +5,11 @@
 
 #include "brave/browser/net/brave_request_handler.h"
 
-#include <algorithm>
 #include <utility>
 
 #include "base/containers/contains.h"
 #include "base/feature_list.h"
+#include "base/notreached.h"
 #include "base/task/post_task.h"
 #include "brave/browser/net/brave_ad_block_csp_network_delegate_helper.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
@@ -50,7 +50,8 @@
 #include "brave/browser/net/decentralized_dns_network_delegate_helper.h"
 #endif
 
-static bool IsInternalScheme(std::shared_ptr<brave::BraveRequestInfo> ctx) {
+static bool IsInternalScheme(
+    const std::shared_ptr<brave::BraveRequestInfo>& ctx) {
   DCHECK(ctx);
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   if (ctx->request_url.SchemeIs(extensions::kExtensionScheme))
@@ -67,71 +68,65 @@ BraveRequestHandler::BraveRequestHandler() {
 BraveRequestHandler::~BraveRequestHandler() = default;
 
 void BraveRequestHandler::SetupCallbacks() {
-  brave::OnBeforeURLRequestCallback callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_.push_back(
+      brave::OnBeforeURLRequest_SiteHacksWork);
+  before_url_request_callbacks_.push_back(
+      brave::OnBeforeURLRequest_AdBlockTPPreWork);
+  before_url_request_callbacks_.push_back(
+      brave::OnBeforeURLRequest_HttpsePreFileWork);
+  before_url_request_callbacks_.push_back(
+      brave::OnBeforeURLRequest_CommonStaticRedirectWork);
 
 #if BUILDFLAG(DECENTRALIZED_DNS_ENABLED)
-  callback = base::BindRepeating(
+  before_url_request_callbacks_.push_back(
       decentralized_dns::OnBeforeURLRequest_DecentralizedDnsPreRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
 #endif
 
-  callback = base::BindRepeating(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_.push_back(brave_rewards::OnBeforeURLRequest);
 
 #if BUILDFLAG(ENABLE_IPFS)
   if (base::FeatureList::IsEnabled(ipfs::features::kIpfsFeature)) {
-    callback = base::BindRepeating(ipfs::OnBeforeURLRequest_IPFSRedirectWork);
-    before_url_request_callbacks_.push_back(callback);
-    brave::OnHeadersReceivedCallback ipfs_headers_received_callback =
-        base::BindRepeating(ipfs::OnHeadersReceived_IPFSRedirectWork);
-    headers_received_callbacks_.push_back(ipfs_headers_received_callback);
+    before_url_request_callbacks_.push_back(
+        ipfs::OnBeforeURLRequest_IPFSRedirectWork);
+    headers_received_callbacks_.push_back(
+        ipfs::OnHeadersReceived_IPFSRedirectWork);
   }
 #endif
 
-  brave::OnBeforeStartTransactionCallback start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_SiteHacksWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
-
-  start_transaction_callback = base::BindRepeating(
+  before_start_transaction_callbacks_.push_back(
+      brave::OnBeforeStartTransaction_SiteHacksWork);
+  before_start_transaction_callbacks_.push_back(
       brave::OnBeforeStartTransaction_GlobalPrivacyControlWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
-
-  start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_BraveServiceKey);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  before_start_transaction_callbacks_.push_back(
+      brave::OnBeforeStartTransaction_BraveServiceKey);
 
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
-  start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_ReferralsWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  before_start_transaction_callbacks_.push_back(
+      brave::OnBeforeStartTransaction_ReferralsWork);
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
-  brave::OnHeadersReceivedCallback headers_received_callback =
-      base::BindRepeating(webtorrent::OnHeadersReceived_TorrentRedirectWork);
-  headers_received_callbacks_.push_back(headers_received_callback);
+  headers_received_callbacks_.push_back(
+      webtorrent::OnHeadersReceived_TorrentRedirectWork);
 #endif
 
   if (base::FeatureList::IsEnabled(
           ::brave_shields::features::kBraveAdblockCspRules)) {
-    brave::OnHeadersReceivedCallback headers_received_callback2 =
-        base::BindRepeating(brave::OnHeadersReceived_AdBlockCspWork);
-    headers_received_callbacks_.push_back(headers_received_callback2);
+    headers_received_callbacks_.push_back(
+        brave::OnHeadersReceived_AdBlockCspWork);
   }
 }
 
+void BraveRequestHandler::SetCallbacksForTesting(
+    std::vector<brave::OnBeforeURLRequestCallback> before_url_request,
+    std::vector<brave::OnBeforeStartTransactionCallback>
+        before_start_transaction,
+    std::vector<brave::OnHeadersReceivedCallback> headers_received) {
+  before_url_request_callbacks_ = std::move(before_url_request);
+  before_start_transaction_callbacks_ = std::move(before_start_transaction);
+  headers_received_callbacks_ = std::move(headers_received);
+}
+
 bool BraveRequestHandler::IsRequestIdentifierValid(
     uint64_t request_identifier) {
   return base::Contains(callbacks_, request_identifier);
@@ -146,9 +141,7 @@ int BraveRequestHandler::OnBeforeURLRequest(
   }
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartEvent(std::move(ctx), std::move(callback));
 }
 
 int BraveRequestHandler::OnBeforeStartTransaction(
@@ -160,9 +153,7 @@ int BraveRequestHandler::OnBeforeStartTransaction(
   }
   ctx->event_type = brave::kOnBeforeStartTransaction;
   ctx->headers = headers;
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartEvent(std::move(ctx), std::move(callback));
 }
 
 int BraveRequestHandler::OnHeadersReceived(
@@ -183,36 +174,57 @@ int BraveRequestHandler::OnHeadersReceived(
     return net::OK;
   }
 
-  callbacks_[ctx->request_identifier] = std::move(callback);
   ctx->event_type = brave::kOnHeadersReceived;
   ctx->original_response_headers = original_response_headers;
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
-
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartEvent(std::move(ctx), std::move(callback));
 }
 
 void BraveRequestHandler::OnURLRequestDestroyed(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
-  if (base::Contains(callbacks_, ctx->request_identifier)) {
-    callbacks_.erase(ctx->request_identifier);
-  }
+  callbacks_.erase(ctx->request_identifier);
 }
 
 void BraveRequestHandler::RunCallbackForRequestIdentifier(
     uint64_t request_identifier,
     int rv) {
-  std::map<uint64_t, net::CompletionOnceCallback>::iterator it =
-      callbacks_.find(request_identifier);
+  auto it = callbacks_.find(request_identifier);
+  DCHECK(it != callbacks_.end());
+  net::CompletionOnceCallback callback = std::move(it->second);
+  callbacks_.erase(it);
   // We intentionally do the async call to maintain the proper flow
   // of URLLoader callbacks.
   base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(std::move(it->second), rv));
+                 base::BindOnce(std::move(callback), rv));
+}
+
+int BraveRequestHandler::StartEvent(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    net::CompletionOnceCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  const uint64_t request_identifier = ctx->request_identifier;
+  // Registered up front as stages may resume the request before returning.
+  // The ad-block, HTTPSE and CSP stages resume it from a posted reply, the
+  // decentralized DNS stage resumes it inline when JsonRpcService rejects the
+  // name synchronously. Either way RunNextCallback owns the completion once a
+  // stage has returned net::ERR_IO_PENDING.
+  callbacks_[request_identifier] = std::move(callback);
+
+  int rv = RunCallbacks(ctx);
+  if (rv == net::ERR_IO_PENDING)
+    return rv;
+  if (rv == net::OK || rv == net::ERR_BLOCKED_BY_CLIENT) {
+    // Every stage completed inline, let the caller continue synchronously
+    // instead of posting |callback|.
+    callbacks_.erase(request_identifier);
+    return rv;
+  }
+  RunCallbackForRequestIdentifier(request_identifier, rv);
+  return net::ERR_IO_PENDING;
 }
 
-// TODO(iefremov): Merge all callback containers into one and run only one loop
-// instead of many (issues/5574).
+// Resumes the pipeline once an asynchronous stage is done.
 void BraveRequestHandler::RunNextCallback(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -221,63 +233,44 @@ void BraveRequestHandler::RunNextCallback(
     return;
   }
 
-  // Continue processing callbacks until we hit one that returns PENDING
-  int rv = net::OK;
+  int rv = RunCallbacks(ctx);
+  if (rv != net::ERR_IO_PENDING)
+    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+}
 
-  if (ctx->event_type == brave::kOnBeforeRequest) {
-    while (before_url_request_callbacks_.size() !=
-           ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
-          before_url_request_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::BindRepeating(&BraveRequestHandler::RunNextCallback,
-                              weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
+int BraveRequestHandler::RunCallbacks(
+    const std::shared_ptr<brave::BraveRequestInfo>& ctx) {
+  const size_t callback_count = GetCallbackCount(ctx->event_type);
+  if (ctx->next_url_request_index != callback_count) {
+    // Shared by all the stages, only asynchronous ones keep a copy.
+    const brave::ResponseCallback next_callback =
+        base::BindRepeating(&BraveRequestHandler::RunNextCallback,
+                            weak_factory_.GetWeakPtr(), ctx);
+
+    // Continue processing callbacks until we hit one that returns PENDING
+    while (ctx->next_url_request_index != callback_count) {
+      const size_t index = ctx->next_url_request_index++;
+      int rv = net::OK;
+      switch (ctx->event_type) {
+        case brave::kOnBeforeRequest:
+          rv = before_url_request_callbacks_[index](next_callback, ctx);
+          break;
+        case brave::kOnBeforeStartTransaction:
+          rv = before_start_transaction_callbacks_[index](ctx->headers,
+                                                          next_callback, ctx);
+          break;
+        case brave::kOnHeadersReceived:
+          rv = headers_received_callbacks_[index](
+              ctx->original_response_headers, ctx->override_response_headers,
+              ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+          break;
+        default:
+          NOTREACHED();
+          break;
       }
+      if (rv != net::OK)
+        return rv;
     }
-  } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
-    while (before_start_transaction_callbacks_.size() !=
-           ctx->next_url_request_index) {
-      brave::OnBeforeStartTransactionCallback callback =
-          before_start_transaction_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::BindRepeating(&BraveRequestHandler::RunNextCallback,
-                              weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(ctx->headers, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
-    }
-  } else if (ctx->event_type == brave::kOnHeadersReceived) {
-    while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnHeadersReceivedCallback callback =
-          headers_received_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::BindRepeating(&BraveRequestHandler::RunNextCallback,
-                              weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(ctx->original_response_headers,
-                        ctx->override_response_headers,
-                        ctx->allowed_unsafe_redirect_url, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
-    }
-  }
-
-  if (rv != net::OK) {
-    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
-    return;
   }
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
@@ -289,11 +282,24 @@ void BraveRequestHandler::RunNextCallback(
     if (ctx->blocked_by == brave::kAdBlocked ||
         ctx->blocked_by == brave::kOtherBlocked) {
       if (!ctx->ShouldMockRequest()) {
-        RunCallbackForRequestIdentifier(ctx->request_identifier,
-                                        net::ERR_BLOCKED_BY_CLIENT);
-        return;
+        return net::ERR_BLOCKED_BY_CLIENT;
       }
     }
   }
-  RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+  return net::OK;
+}
+
+size_t BraveRequestHandler::GetCallbackCount(
+    brave::BraveNetworkDelegateEventType event_type) {
+  switch (event_type) {
+    case brave::kOnBeforeRequest:
+      return before_url_request_callbacks_.size();
+    case brave::kOnBeforeStartTransaction:
+      return before_start_transaction_callbacks_.size();
+    case brave::kOnHeadersReceived:
+      return headers_received_callbacks_.size();
+    default:
+      NOTREACHED();
+      return 0;
+  }
 }
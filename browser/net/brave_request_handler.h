@@ -6,11 +6,12 @@
 #ifndef BRAVE_BROWSER_NET_BRAVE_REQUEST_HANDLER_H_
 #define BRAVE_BROWSER_NET_BRAVE_REQUEST_HANDLER_H_
 
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/memory/weak_ptr.h"
 #include "brave/browser/net/url_context.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/completion_once_callback.h"
@@ -28,6 +29,9 @@ class BraveRequestHandler {
 
   bool IsRequestIdentifierValid(uint64_t request_identifier);
 
+  // The following return net::ERR_IO_PENDING if a stage suspended the request,
+  // |callback| is then run once all stages are done. Otherwise the result is
+  // returned synchronously and |callback| is not run.
   int OnBeforeURLRequest(std::shared_ptr<brave::BraveRequestInfo> ctx,
                          net::CompletionOnceCallback callback,
                          GURL* new_url);
@@ -45,16 +49,31 @@ class BraveRequestHandler {
   void OnURLRequestDestroyed(std::shared_ptr<brave::BraveRequestInfo> ctx);
   void RunCallbackForRequestIdentifier(uint64_t request_identifier, int rv);
 
+  void SetCallbacksForTesting(
+      std::vector<brave::OnBeforeURLRequestCallback> before_url_request,
+      std::vector<brave::OnBeforeStartTransactionCallback>
+          before_start_transaction,
+      std::vector<brave::OnHeadersReceivedCallback> headers_received);
+
  private:
   void SetupCallbacks();
+  // Runs the stages of the current event of |ctx|, returns
+  // net::ERR_IO_PENDING if a stage suspended the request.
+  int StartEvent(std::shared_ptr<brave::BraveRequestInfo> ctx,
+                 net::CompletionOnceCallback callback);
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  int RunCallbacks(const std::shared_ptr<brave::BraveRequestInfo>& ctx);
+  size_t GetCallbackCount(brave::BraveNetworkDelegateEventType event_type);
 
   std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
   std::vector<brave::OnBeforeStartTransactionCallback>
       before_start_transaction_callbacks_;
   std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
 
-  std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  // Callbacks of the requests whose current event is being processed. Request
+  // identifiers are increasing so new entries are appended to the end, and
+  // entries are dropped as soon as the event completes.
+  base::flat_map<uint64_t, net::CompletionOnceCallback> callbacks_;
 
   base::WeakPtrFactory<BraveRequestHandler> weak_factory_{this};
 };
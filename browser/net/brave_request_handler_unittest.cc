@@ -0,0 +1,241 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_request_handler.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/browser/net/url_context.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_request_headers.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+size_t g_stages_run = 0;
+
+int SyncStage(const brave::ResponseCallback& next_callback,
+              std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  ++g_stages_run;
+  return net::OK;
+}
+
+// Suspends every tenth request, as the ad-block, HTTPSE and CSP stages do
+// when they hop to their own sequence.
+int SometimesAsyncStage(const brave::ResponseCallback& next_callback,
+                        std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  ++g_stages_run;
+  if (ctx->request_identifier % 10)
+    return net::OK;
+  base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE, next_callback);
+  return net::ERR_IO_PENDING;
+}
+
+// Resumes the request before returning net::ERR_IO_PENDING, as the
+// decentralized DNS stage does when JsonRpcService rejects the name up front.
+int ResumeInlineStage(const brave::ResponseCallback& next_callback,
+                      std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  ++g_stages_run;
+  next_callback.Run();
+  return net::ERR_IO_PENDING;
+}
+
+int RedirectStage(const brave::ResponseCallback& next_callback,
+                  std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  ++g_stages_run;
+  ctx->new_url_spec = "https://redirected.example.com/";
+  return net::OK;
+}
+
+int BlockStage(const brave::ResponseCallback& next_callback,
+               std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  ++g_stages_run;
+  ctx->blocked_by = brave::kAdBlocked;
+  return net::OK;
+}
+
+int SyncStartTransactionStage(net::HttpRequestHeaders* headers,
+                              const brave::ResponseCallback& next_callback,
+                              std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  ++g_stages_run;
+  headers->SetHeader("Sec-GPC", "1");
+  return net::OK;
+}
+
+int SyncHeadersReceivedStage(
+    const net::HttpResponseHeaders* original_response_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
+    GURL* allowed_unsafe_redirect_url,
+    const brave::ResponseCallback& next_callback,
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  ++g_stages_run;
+  return net::OK;
+}
+
+}  // namespace
+
+class BraveRequestHandlerTest : public testing::Test {
+ public:
+  BraveRequestHandlerTest() = default;
+  ~BraveRequestHandlerTest() override = default;
+
+  void SetUp() override {
+    g_stages_run = 0;
+    handler_ = std::make_unique<BraveRequestHandler>();
+  }
+
+  void TearDown() override { handler_.reset(); }
+
+  BraveRequestHandler* handler() { return handler_.get(); }
+
+  // Builds the context of a new request, as MakeCTX does for each event.
+  std::shared_ptr<brave::BraveRequestInfo> MakeCTX(uint64_t request_id) {
+    auto ctx = std::make_shared<brave::BraveRequestInfo>(GURL(
+        base::StringPrintf("https://cdn.example.com/%d.js",
+                           static_cast<int>(request_id))));
+    ctx->request_identifier = request_id;
+    return ctx;
+  }
+
+  net::CompletionOnceCallback RecordResult() {
+    return base::BindLambdaForTesting([&](int rv) { results_.push_back(rv); });
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  std::vector<int> results_;
+
+ private:
+  std::unique_ptr<BraveRequestHandler> handler_;
+};
+
+TEST_F(BraveRequestHandlerTest, SyncStagesCompleteInline) {
+  handler()->SetCallbacksForTesting({SyncStage, SyncStage}, {}, {});
+  GURL new_url;
+  EXPECT_EQ(handler()->OnBeforeURLRequest(MakeCTX(1), RecordResult(),
+                                          &new_url),
+            net::OK);
+  EXPECT_EQ(g_stages_run, 2u);
+  EXPECT_FALSE(handler()->IsRequestIdentifierValid(1));
+  task_environment_.RunUntilIdle();
+  // The caller continues on its own, the callback is not run.
+  EXPECT_TRUE(results_.empty());
+}
+
+TEST_F(BraveRequestHandlerTest, AsyncStageSuspendsPipeline) {
+  handler()->SetCallbacksForTesting(
+      {SyncStage, SometimesAsyncStage, RedirectStage}, {}, {});
+  GURL new_url;
+  EXPECT_EQ(handler()->OnBeforeURLRequest(MakeCTX(10), RecordResult(),
+                                          &new_url),
+            net::ERR_IO_PENDING);
+  EXPECT_EQ(g_stages_run, 2u);
+  EXPECT_TRUE(handler()->IsRequestIdentifierValid(10));
+
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(g_stages_run, 3u);
+  EXPECT_EQ(results_, std::vector<int>({net::OK}));
+  EXPECT_EQ(new_url, GURL("https://redirected.example.com/"));
+  EXPECT_FALSE(handler()->IsRequestIdentifierValid(10));
+}
+
+TEST_F(BraveRequestHandlerTest, StageResumesBeforeReturningPending) {
+  handler()->SetCallbacksForTesting(
+      {SyncStage, ResumeInlineStage, RedirectStage}, {}, {});
+  GURL new_url;
+  EXPECT_EQ(handler()->OnBeforeURLRequest(MakeCTX(1), RecordResult(),
+                                          &new_url),
+            net::ERR_IO_PENDING);
+  // The remaining stages ran from the nested resume, and the completion is
+  // posted exactly once.
+  EXPECT_EQ(g_stages_run, 3u);
+  EXPECT_FALSE(handler()->IsRequestIdentifierValid(1));
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(results_, std::vector<int>({net::OK}));
+  EXPECT_EQ(new_url, GURL("https://redirected.example.com/"));
+}
+
+TEST_F(BraveRequestHandlerTest, RequestDestroyedWhileSuspended) {
+  handler()->SetCallbacksForTesting({SometimesAsyncStage, SyncStage}, {}, {});
+  auto ctx = MakeCTX(10);
+  GURL new_url;
+  EXPECT_EQ(handler()->OnBeforeURLRequest(ctx, RecordResult(), &new_url),
+            net::ERR_IO_PENDING);
+  handler()->OnURLRequestDestroyed(ctx);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(g_stages_run, 1u);
+  EXPECT_TRUE(results_.empty());
+}
+
+TEST_F(BraveRequestHandlerTest, RedirectAndBlock) {
+  handler()->SetCallbacksForTesting({RedirectStage}, {}, {});
+  GURL new_url;
+  EXPECT_EQ(handler()->OnBeforeURLRequest(MakeCTX(1), RecordResult(),
+                                          &new_url),
+            net::OK);
+  EXPECT_EQ(new_url, GURL("https://redirected.example.com/"));
+
+  handler()->SetCallbacksForTesting({BlockStage, SyncStage}, {}, {});
+  EXPECT_EQ(handler()->OnBeforeURLRequest(MakeCTX(2), RecordResult(),
+                                          &new_url),
+            net::ERR_BLOCKED_BY_CLIENT);
+  EXPECT_EQ(g_stages_run, 3u);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(results_.empty());
+}
+
+// Drives synthetic requests through the three events with the same number
+// of stages as a default profile.
+TEST_F(BraveRequestHandlerTest, ManyRequests) {
+  constexpr uint64_t kRequestCount = 5000;
+  handler()->SetCallbacksForTesting(
+      {SyncStage, SometimesAsyncStage, SyncStage, SyncStage, SyncStage},
+      {SyncStartTransactionStage, SyncStartTransactionStage,
+       SyncStartTransactionStage},
+      {SyncHeadersReceivedStage});
+
+  size_t completed_inline = 0;
+  GURL new_url;
+  net::HttpRequestHeaders headers;
+  scoped_refptr<net::HttpResponseHeaders> override_headers;
+  base::ElapsedTimer timer;
+  for (uint64_t request_id = 1; request_id <= kRequestCount; ++request_id) {
+    if (handler()->OnBeforeURLRequest(MakeCTX(request_id), RecordResult(),
+                                      &new_url) == net::OK) {
+      ++completed_inline;
+    }
+  }
+  task_environment_.RunUntilIdle();
+  for (uint64_t request_id = 1; request_id <= kRequestCount; ++request_id) {
+    if (handler()->OnBeforeStartTransaction(
+            MakeCTX(request_id), RecordResult(), &headers) == net::OK) {
+      ++completed_inline;
+    }
+    if (handler()->OnHeadersReceived(MakeCTX(request_id), RecordResult(),
+                                     nullptr, &override_headers,
+                                     &new_url) == net::OK) {
+      ++completed_inline;
+    }
+  }
+  task_environment_.RunUntilIdle();
+  VLOG(1) << "Ran " << kRequestCount << " requests through 3 events in "
+          << timer.Elapsed() << ", " << completed_inline
+          << " events completed inline";
+
+  EXPECT_EQ(g_stages_run, kRequestCount * 9);
+  // Only the requests suspended by SometimesAsyncStage run their callback.
+  EXPECT_EQ(results_.size(), kRequestCount / 10);
+  EXPECT_EQ(completed_inline + results_.size(), kRequestCount * 3);
+  for (uint64_t request_id = 1; request_id <= kRequestCount; ++request_id)
+    EXPECT_FALSE(handler()->IsRequestIdentifierValid(request_id));
+}
@@ -5,13 +5,15 @@
 
 #include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
 
-#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/no_destructor.h"
+#include "base/notreached.h"
 #include "base/strings/string_piece_forward.h"
 #include "brave/browser/net/brave_geolocation_buildflags.h"
+#include "brave/browser/net/host_indexed_url_matcher.h"
 #include "brave/common/network_constants.h"
 #include "extensions/common/url_pattern.h"
 #include "net/base/net_errors.h"
@@ -30,6 +32,48 @@ base::StringPiece GetSafeBrowsingEndpoint() {
   return SAFEBROWSING_ENDPOINT;
 }
 
+enum StaticRedirectRule {
+  kGeolocationRule,
+  kSafeBrowsingRule,
+  kSafeBrowsingFileCheckRule,
+  kSafeBrowsingCrxListRule,
+  kCRXDownloadRule,
+  kAutofillRule,
+  kCRLSetRule,
+  kWidevineRule,
+  kGoogleDownloadRule,
+};
+
+const HostIndexedURLMatcher& GetStaticRedirectMatcher() {
+  constexpr int kHttpOrHttps =
+      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+  // To-Do (@jumde) - Update the naming for the CRLSet prefixes
+  // https://github.com/brave/brave-browser/issues/10314
+  static const base::NoDestructor<HostIndexedURLMatcher> matcher(
+      std::vector<HostIndexedURLMatcher::Rule>({
+          {URLPattern::SCHEME_HTTPS, kGeoLocationsPattern, kGeolocationRule},
+          {URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix, kSafeBrowsingRule,
+           true},
+          {URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix,
+           kSafeBrowsingFileCheckRule, true},
+          {URLPattern::SCHEME_HTTPS, kSafeBrowsingCrxListPrefix,
+           kSafeBrowsingCrxListRule, true},
+          {kHttpOrHttps, kCRXDownloadPrefix, kCRXDownloadRule},
+          {URLPattern::SCHEME_HTTPS, kAutofillPrefix, kAutofillRule},
+          {kHttpOrHttps, kCRLSetPrefix1, kCRLSetRule},
+          {kHttpOrHttps, kCRLSetPrefix2, kCRLSetRule},
+          {kHttpOrHttps, kCRLSetPrefix3, kCRLSetRule},
+          {kHttpOrHttps, kCRLSetPrefix4, kCRLSetRule},
+          // Widevine is excluded from the gvt1.com and dl.google.com
+          // redirects, so its rules must come first.
+          {kHttpOrHttps, kWidevineGvt1Prefix, kWidevineRule},
+          {kHttpOrHttps, "*://*.gvt1.com/*", kGoogleDownloadRule},
+          {kHttpOrHttps, kWidevineGoogleDlPrefix, kWidevineRule},
+          {kHttpOrHttps, "*://dl.google.com/*", kGoogleDownloadRule},
+      }));
+  return *matcher;
+}
+
 }  // namespace
 
 void SetSafeBrowsingEndpointForTesting(bool testing) {
@@ -51,127 +95,54 @@ int OnBeforeURLRequest_StaticRedirectWork(
 int OnBeforeURLRequest_StaticRedirectWorkForGURL(
     const GURL& request_url,
     GURL* new_url) {
-  GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingPrefix);
-  static URLPattern safebrowsingfilecheck_pattern(URLPattern::SCHEME_HTTPS,
-                                                  kSafeBrowsingFileCheckPrefix);
-  static URLPattern safebrowsingcrxlist_pattern(URLPattern::SCHEME_HTTPS,
-                                                kSafeBrowsingCrxListPrefix);
-
-  // To-Do (@jumde) - Update the naming for the variables below
-  // https://github.com/brave/brave-browser/issues/10314
-  static URLPattern crlSet_pattern1(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix1);
-  static URLPattern crlSet_pattern2(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix2);
-  static URLPattern crlSet_pattern3(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix3);
-  static URLPattern crlSet_pattern4(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix4);
-  static URLPattern crxDownload_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRXDownloadPrefix);
-  static URLPattern autofill_pattern(
-      URLPattern::SCHEME_HTTPS, kAutofillPrefix);
-  static URLPattern gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, "*://*.gvt1.com/*");
-  static URLPattern googleDl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://dl.google.com/*");
-
-  static URLPattern widevine_gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      kWidevineGvt1Prefix);
-  static URLPattern widevine_google_dl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      kWidevineGoogleDlPrefix);
-
-  if (geo_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(BUILDFLAG(GOOGLEAPIS_URL));
+  absl::optional<int> rule = GetStaticRedirectMatcher().Match(request_url);
+  if (!rule)
     return net::OK;
-  }
 
+  GURL::Replacements replacements;
   auto safebrowsing_endpoint = GetSafeBrowsingEndpoint();
-  if (!safebrowsing_endpoint.empty() &&
-      safeBrowsing_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(safebrowsing_endpoint);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (!safebrowsing_endpoint.empty() &&
-      safebrowsingfilecheck_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(kBraveSafeBrowsingSslProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (!safebrowsing_endpoint.empty() &&
-      safebrowsingcrxlist_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(kBraveSafeBrowsing2Proxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crxDownload_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crxdownload.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (autofill_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveStaticProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+  switch (*rule) {
+    case kGeolocationRule:
+      *new_url = GURL(BUILDFLAG(GOOGLEAPIS_URL));
+      return net::OK;
+    case kSafeBrowsingRule:
+      if (safebrowsing_endpoint.empty())
+        return net::OK;
+      replacements.SetHostStr(safebrowsing_endpoint);
+      break;
+    case kSafeBrowsingFileCheckRule:
+      if (safebrowsing_endpoint.empty())
+        return net::OK;
+      replacements.SetHostStr(kBraveSafeBrowsingSslProxy);
+      break;
+    case kSafeBrowsingCrxListRule:
+      if (safebrowsing_endpoint.empty())
+        return net::OK;
+      replacements.SetHostStr(kBraveSafeBrowsing2Proxy);
+      break;
+    case kCRXDownloadRule:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr("crxdownload.brave.com");
+      break;
+    case kAutofillRule:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveStaticProxy);
+      break;
+    case kCRLSetRule:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr("redirector.brave.com");
+      break;
+    case kWidevineRule:
+      return net::OK;
+    case kGoogleDownloadRule:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveRedirectorProxy);
+      break;
+    default:
+      NOTREACHED();
+      return net::OK;
   }
-
-  if (crlSet_pattern1.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("redirector.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern2.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("redirector.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern3.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("redirector.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern4.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("redirector.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (gvt1_pattern.MatchesURL(request_url) &&
-      !widevine_gvt1_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (googleDl_pattern.MatchesURL(request_url) &&
-      !widevine_google_dl_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
+  *new_url = request_url.ReplaceComponents(replacements);
   return net::OK;
 }
 
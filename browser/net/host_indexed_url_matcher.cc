@@ -0,0 +1,85 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/host_indexed_url_matcher.h"
+
+#include <limits>
+#include <utility>
+
+#include "base/check.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+HostIndexedURLMatcher::HostIndexedURLMatcher(const std::vector<Rule>& rules) {
+  rules_.reserve(rules.size());
+  for (const auto& rule : rules) {
+    URLPattern pattern(rule.valid_schemes);
+    const URLPattern::ParseResult result = pattern.Parse(rule.pattern);
+    DCHECK_EQ(result, URLPattern::ParseResult::kSuccess) << rule.pattern;
+
+    const size_t index = rules_.size();
+    if (pattern.host().empty())
+      any_host_.push_back(index);
+    else if (pattern.match_subdomains())
+      domain_hosts_[pattern.host()].push_back(index);
+    else
+      exact_hosts_[pattern.host()].push_back(index);
+    rules_.push_back({std::move(pattern), rule.id, rule.host_only});
+  }
+}
+
+HostIndexedURLMatcher::~HostIndexedURLMatcher() = default;
+
+absl::optional<int> HostIndexedURLMatcher::Match(const GURL& url) const {
+  size_t best = std::numeric_limits<size_t>::max();
+  FindFirstMatch(any_host_, url, &best);
+
+  base::StringPiece host = url.host_piece();
+  // URLPattern ignores the trailing dot of fully qualified hosts.
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+
+  auto exact_it = exact_hosts_.find(host);
+  if (exact_it != exact_hosts_.end())
+    FindFirstMatch(exact_it->second, url, &best);
+
+  // Probe the host and each of its parent domains.
+  while (!host.empty()) {
+    auto domain_it = domain_hosts_.find(host);
+    if (domain_it != domain_hosts_.end())
+      FindFirstMatch(domain_it->second, url, &best);
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+
+  if (best == std::numeric_limits<size_t>::max())
+    return absl::nullopt;
+  return rules_[best].id;
+}
+
+bool HostIndexedURLMatcher::Matches(size_t rule_index, const GURL& url) const {
+  const CompiledRule& rule = rules_[rule_index];
+  return rule.host_only ? rule.pattern.MatchesHost(url)
+                        : rule.pattern.MatchesURL(url);
+}
+
+void HostIndexedURLMatcher::FindFirstMatch(
+    const std::vector<size_t>& rule_indexes,
+    const GURL& url,
+    size_t* best) const {
+  for (size_t index : rule_indexes) {
+    if (index >= *best)
+      return;
+    if (Matches(index, url)) {
+      *best = index;
+      return;
+    }
+  }
+}
+
+}  // namespace brave
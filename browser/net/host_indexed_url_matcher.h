@@ -0,0 +1,71 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_HOST_INDEXED_URL_MATCHER_H_
+#define BRAVE_BROWSER_NET_HOST_INDEXED_URL_MATCHER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/strings/string_piece.h"
+#include "extensions/common/url_pattern.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+class GURL;
+
+namespace brave {
+
+// Matches URLs against an ordered table of URLPatterns, the first matching
+// rule wins. Rules are indexed by the host of their pattern so that a URL is
+// only tested against the patterns for its host and its parent domains, and
+// a URL matching no rule costs one lookup per domain label, without any
+// allocation.
+class HostIndexedURLMatcher {
+ public:
+  struct Rule {
+    int valid_schemes;
+    base::StringPiece pattern;
+    int id;
+    // Only match the host of |pattern|, ignoring its scheme and path.
+    bool host_only = false;
+  };
+
+  explicit HostIndexedURLMatcher(const std::vector<Rule>& rules);
+  HostIndexedURLMatcher(const HostIndexedURLMatcher&) = delete;
+  HostIndexedURLMatcher& operator=(const HostIndexedURLMatcher&) = delete;
+  ~HostIndexedURLMatcher();
+
+  // Returns the id of the first rule matching |url|.
+  absl::optional<int> Match(const GURL& url) const;
+
+ private:
+  struct CompiledRule {
+    URLPattern pattern;
+    int id;
+    bool host_only;
+  };
+
+  bool Matches(size_t rule_index, const GURL& url) const;
+  // Lowers |*best| to the first rule of |rule_indexes| matching |url|.
+  void FindFirstMatch(const std::vector<size_t>& rule_indexes,
+                      const GURL& url,
+                      size_t* best) const;
+
+  std::vector<CompiledRule> rules_;
+  using HostIndex =
+      base::flat_map<std::string, std::vector<size_t>, std::less<>>;
+  // <host, indexes of rules for exactly that host, in rule order>
+  HostIndex exact_hosts_;
+  // <host, indexes of rules for that host and its subdomains, in rule order>
+  HostIndex domain_hosts_;
+  // Indexes of rules matching any host.
+  std::vector<size_t> any_host_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_HOST_INDEXED_URL_MATCHER_H_
@@ -0,0 +1,180 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/host_indexed_url_matcher.h"
+
+#include <string>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/common/network_constants.h"
+#include "extensions/common/url_pattern.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+constexpr int kHttpOrHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+// Same table as the static redirect helper.
+const std::vector<HostIndexedURLMatcher::Rule>& GetRedirectRules() {
+  static const std::vector<HostIndexedURLMatcher::Rule> rules({
+      {URLPattern::SCHEME_HTTPS, kGeoLocationsPattern, 0},
+      {URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix, 1, true},
+      {URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix, 2, true},
+      {URLPattern::SCHEME_HTTPS, kSafeBrowsingCrxListPrefix, 3, true},
+      {kHttpOrHttps, kCRXDownloadPrefix, 4},
+      {URLPattern::SCHEME_HTTPS, kAutofillPrefix, 5},
+      {kHttpOrHttps, kCRLSetPrefix1, 6},
+      {kHttpOrHttps, kCRLSetPrefix2, 6},
+      {kHttpOrHttps, kCRLSetPrefix3, 6},
+      {kHttpOrHttps, kCRLSetPrefix4, 6},
+      {kHttpOrHttps, kWidevineGvt1Prefix, 7},
+      {kHttpOrHttps, "*://*.gvt1.com/*", 8},
+      {kHttpOrHttps, kWidevineGoogleDlPrefix, 7},
+      {kHttpOrHttps, "*://dl.google.com/*", 8},
+  });
+  return rules;
+}
+
+}  // namespace
+
+TEST(HostIndexedURLMatcherTest, ExactHost) {
+  HostIndexedURLMatcher matcher({{kHttpOrHttps, "https://a.com/foo/*", 1}});
+  EXPECT_EQ(matcher.Match(GURL("https://a.com/foo/bar")), 1);
+  EXPECT_EQ(matcher.Match(GURL("http://a.com/foo/")), 1);
+  EXPECT_FALSE(matcher.Match(GURL("http://a.com/bar")));
+  EXPECT_FALSE(matcher.Match(GURL("https://b.a.com/foo/bar")));
+  EXPECT_FALSE(matcher.Match(GURL("https://aa.com/foo/bar")));
+  EXPECT_FALSE(matcher.Match(GURL("ftp://a.com/foo/bar")));
+}
+
+TEST(HostIndexedURLMatcherTest, Subdomains) {
+  HostIndexedURLMatcher matcher({{kHttpOrHttps, "*://*.a.com/*", 1}});
+  EXPECT_EQ(matcher.Match(GURL("https://a.com/")), 1);
+  EXPECT_EQ(matcher.Match(GURL("https://b.a.com/foo")), 1);
+  EXPECT_EQ(matcher.Match(GURL("https://c.b.a.com/foo")), 1);
+  EXPECT_FALSE(matcher.Match(GURL("https://ba.com/")));
+  EXPECT_FALSE(matcher.Match(GURL("https://a.com.b.com/")));
+}
+
+TEST(HostIndexedURLMatcherTest, AnyHost) {
+  HostIndexedURLMatcher matcher({{kHttpOrHttps, "*://*/foo/*", 1}});
+  EXPECT_EQ(matcher.Match(GURL("https://a.com/foo/bar")), 1);
+  EXPECT_EQ(matcher.Match(GURL("http://127.0.0.1/foo/")), 1);
+  EXPECT_FALSE(matcher.Match(GURL("https://a.com/bar")));
+}
+
+TEST(HostIndexedURLMatcherTest, FirstRuleWins) {
+  HostIndexedURLMatcher matcher({
+      {kHttpOrHttps, "*://*/exception/*", 1},
+      {kHttpOrHttps, "*://*.a.com/*", 2},
+      {kHttpOrHttps, "*://b.a.com/*", 3},
+      {kHttpOrHttps, "*://*/*", 4},
+  });
+  EXPECT_EQ(matcher.Match(GURL("https://b.a.com/exception/")), 1);
+  EXPECT_EQ(matcher.Match(GURL("https://b.a.com/")), 2);
+  EXPECT_EQ(matcher.Match(GURL("https://a.com/")), 2);
+  EXPECT_EQ(matcher.Match(GURL("https://b.com/")), 4);
+
+  HostIndexedURLMatcher reversed({
+      {kHttpOrHttps, "*://b.a.com/*", 3},
+      {kHttpOrHttps, "*://*.a.com/*", 2},
+  });
+  EXPECT_EQ(reversed.Match(GURL("https://b.a.com/")), 3);
+  EXPECT_EQ(reversed.Match(GURL("https://c.a.com/")), 2);
+}
+
+TEST(HostIndexedURLMatcherTest, HostOnly) {
+  HostIndexedURLMatcher matcher(
+      {{kHttpOrHttps, "https://a.com/foo/*", 1, true}});
+  EXPECT_EQ(matcher.Match(GURL("https://a.com/bar")), 1);
+  EXPECT_EQ(matcher.Match(GURL("http://a.com/")), 1);
+  EXPECT_FALSE(matcher.Match(GURL("https://b.com/foo/")));
+}
+
+TEST(HostIndexedURLMatcherTest, TrailingDot) {
+  HostIndexedURLMatcher matcher({
+      {kHttpOrHttps, "https://a.com/*", 1},
+      {kHttpOrHttps, "https://*.b.com/*", 2},
+  });
+  EXPECT_EQ(matcher.Match(GURL("https://a.com./foo")), 1);
+  EXPECT_EQ(matcher.Match(GURL("https://c.b.com./foo")), 2);
+}
+
+// Matches the static redirect table against typical subresource URLs, the
+// vast majority of which match no rule, and compares against testing every
+// pattern in turn as the network delegate helpers used to do.
+TEST(HostIndexedURLMatcherTest, SubresourceURLs) {
+  const auto& rules = GetRedirectRules();
+  HostIndexedURLMatcher matcher(rules);
+  std::vector<URLPattern> patterns;
+  for (const auto& rule : rules)
+    patterns.emplace_back(rule.valid_schemes, rule.pattern);
+
+  std::vector<GURL> urls;
+  const char* kSubresourceFormats[] = {
+      "https://cdn.example%d.com/static/js/app.%d.js",
+      "https://www.site%d.org/images/logo-%d.png",
+      "https://fonts.gstatic.com/s/roboto/v%d/font-%d.woff2",
+      "https://i%d.ytimg.com/vi/%d/hqdefault.jpg",
+      "https://api.service%d.io/v1/items?page=%d",
+  };
+  for (int i = 0; i < 1000; ++i) {
+    for (const char* format : kSubresourceFormats)
+      urls.emplace_back(base::StringPrintf(format, i % 50, i));
+  }
+  // Plus a few URLs which are redirected.
+  urls.emplace_back(
+      "https://www.googleapis.com/geolocation/v1/geolocate?key=1");
+  urls.emplace_back("https://safebrowsing.googleapis.com/v4/threatListUpdates");
+  urls.emplace_back(
+      "https://r3---sn.gvt1.com/edgedl/oimompecagnajdejgnnjijobebaeigek.crx");
+  urls.emplace_back("https://r3---sn.gvt1.com/edgedl/chrome/dict/en.bdic");
+  urls.emplace_back("https://dl.google.com/release2/chrome_component/a.crx");
+
+  std::vector<absl::optional<int>> sequential_results;
+  std::vector<absl::optional<int>> indexed_results;
+  sequential_results.reserve(urls.size());
+  indexed_results.reserve(urls.size());
+
+  base::ElapsedTimer sequential_timer;
+  for (const auto& url : urls) {
+    absl::optional<int> result;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+      if (rules[i].host_only ? patterns[i].MatchesHost(url)
+                             : patterns[i].MatchesURL(url)) {
+        result = rules[i].id;
+        break;
+      }
+    }
+    sequential_results.push_back(result);
+  }
+  const base::TimeDelta sequential_time = sequential_timer.Elapsed();
+
+  base::ElapsedTimer indexed_timer;
+  for (const auto& url : urls)
+    indexed_results.push_back(matcher.Match(url));
+  const base::TimeDelta indexed_time = indexed_timer.Elapsed();
+
+  VLOG(1) << "Matched " << urls.size() << " URLs against " << rules.size()
+          << " rules, sequential: " << sequential_time
+          << ", host indexed: " << indexed_time;
+
+  EXPECT_EQ(sequential_results, indexed_results);
+  // The redirected URLs.
+  const size_t count = urls.size();
+  EXPECT_EQ(indexed_results[count - 5], 0);
+  EXPECT_EQ(indexed_results[count - 4], 1);
+  EXPECT_EQ(indexed_results[count - 3], 7);
+  EXPECT_EQ(indexed_results[count - 2], 8);
+  EXPECT_EQ(indexed_results[count - 1], 8);
+}
+
+}  // namespace brave
@@ -0,0 +1,105 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/shields_settings_cache.h"
+
+#include <memory>
+
+#include "base/memory/ptr_util.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave {
+
+namespace {
+
+// User data key for ShieldsSettingsCache.
+const void* const kShieldsSettingsCacheUserDataKey =
+    &kShieldsSettingsCacheUserDataKey;
+
+// Bounds memory for long sessions, an evicted origin only costs one lookup
+// to add back.
+constexpr size_t kMaxCachedOrigins = 1000;
+
+// The content settings ShieldsSettingsCache::Get reads.
+bool IsShieldsSettingsType(ContentSettingsType content_type) {
+  switch (content_type) {
+    case ContentSettingsType::BRAVE_SHIELDS:
+    case ContentSettingsType::BRAVE_ADS:
+    case ContentSettingsType::BRAVE_COSMETIC_FILTERING:
+    case ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES:
+    case ContentSettingsType::BRAVE_REFERRERS:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+ShieldsSettingsCache::ShieldsSettingsCache(HostContentSettingsMap* map)
+    : map_(map), settings_(kMaxCachedOrigins) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  map_->AddObserver(this);
+}
+
+ShieldsSettingsCache::~ShieldsSettingsCache() {
+  map_->RemoveObserver(this);
+}
+
+// static
+ShieldsSettingsCache* ShieldsSettingsCache::GetForBrowserContext(
+    content::BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  auto* self = static_cast<ShieldsSettingsCache*>(
+      browser_context->GetUserData(kShieldsSettingsCacheUserDataKey));
+  if (!self) {
+    auto* map = HostContentSettingsMapFactory::GetForProfile(
+        Profile::FromBrowserContext(browser_context));
+    self = new ShieldsSettingsCache(map);
+    browser_context->SetUserData(kShieldsSettingsCacheUserDataKey,
+                                 base::WrapUnique(self));
+  }
+  return self;
+}
+
+ShieldsSettings ShieldsSettingsCache::Get(const GURL& url) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  auto it = settings_.Get(url.spec());
+  if (it != settings_.end())
+    return it->second;
+
+  ShieldsSettings settings;
+  settings.shields_enabled =
+      brave_shields::GetBraveShieldsEnabled(map_.get(), url);
+  settings.allow_ads = brave_shields::GetAdControlType(map_.get(), url) ==
+                       brave_shields::ControlType::ALLOW;
+  // Currently, "aggressive" mode is registered as a cosmetic filtering control
+  // type, even though it can also affect network blocking.
+  settings.aggressive_blocking =
+      brave_shields::GetCosmeticFilteringControlType(map_.get(), url) ==
+      brave_shields::ControlType::BLOCK;
+  settings.allow_http_upgradable_resource =
+      !brave_shields::GetHTTPSEverywhereEnabled(map_.get(), url);
+  settings.allow_referrers = brave_shields::AllowReferrers(map_.get(), url);
+  settings_.Put(url.spec(), settings);
+  return settings;
+}
+
+void ShieldsSettingsCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type) {
+  if (IsShieldsSettingsType(content_type))
+    settings_.Clear();
+}
+
+}  // namespace brave
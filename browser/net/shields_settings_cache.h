@@ -0,0 +1,69 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_SHIELDS_SETTINGS_CACHE_H_
+#define BRAVE_BROWSER_NET_SHIELDS_SETTINGS_CACHE_H_
+
+#include <string>
+
+#include "base/containers/lru_cache.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/supports_user_data.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "url/gurl.h"
+
+class HostContentSettingsMap;
+
+namespace content {
+class BrowserContext;
+}
+
+namespace brave {
+
+// Shields settings which apply to every request made under a top frame.
+struct ShieldsSettings {
+  bool shields_enabled = true;
+  bool allow_ads = false;
+  bool aggressive_blocking = false;
+  bool allow_http_upgradable_resource = false;
+  bool allow_referrers = false;
+};
+
+// Remembers the ShieldsSettings of the top frame origins of a profile, so
+// every subresource of a page, and every stage of its request, is served by
+// a single lookup instead of five HostContentSettingsMap queries. The cache
+// keeps the most recently used origins and is dropped whenever one of the
+// content settings it reads changes. There is one |ShieldsSettingsCache| per
+// profile.
+class ShieldsSettingsCache : public base::SupportsUserData::Data,
+                             public content_settings::Observer {
+ public:
+  ShieldsSettingsCache(const ShieldsSettingsCache&) = delete;
+  ShieldsSettingsCache& operator=(const ShieldsSettingsCache&) = delete;
+  ~ShieldsSettingsCache() override;
+
+  static ShieldsSettingsCache* GetForBrowserContext(
+      content::BrowserContext* browser_context);
+
+  ShieldsSettings Get(const GURL& url);
+
+  size_t size_for_testing() const { return settings_.size(); }
+
+ private:
+  explicit ShieldsSettingsCache(HostContentSettingsMap* map);
+
+  // content_settings::Observer overrides:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override;
+
+  scoped_refptr<HostContentSettingsMap> map_;
+  // <url spec, settings>
+  base::LRUCache<std::string, ShieldsSettings> settings_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_SHIELDS_SETTINGS_CACHE_H_
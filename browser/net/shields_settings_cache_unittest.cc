@@ -0,0 +1,193 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/shields_settings_cache.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/browser/net/url_context.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/base/isolation_info.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+using brave_shields::ControlType;
+
+namespace brave {
+
+class ShieldsSettingsCacheTest : public testing::Test {
+ public:
+  ShieldsSettingsCacheTest() = default;
+  ~ShieldsSettingsCacheTest() override = default;
+
+  void SetUp() override { profile_ = std::make_unique<TestingProfile>(); }
+
+  void TearDown() override { profile_.reset(); }
+
+  TestingProfile* profile() { return profile_.get(); }
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(profile());
+  }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+};
+
+TEST_F(ShieldsSettingsCacheTest, InvalidatedOnContentSettingChange) {
+  auto* cache = ShieldsSettingsCache::GetForBrowserContext(profile());
+  EXPECT_EQ(cache, ShieldsSettingsCache::GetForBrowserContext(profile()));
+
+  const GURL url("https://brave.com/");
+  const GURL other_url("https://example.com/");
+  ShieldsSettings settings = cache->Get(url);
+  EXPECT_TRUE(settings.shields_enabled);
+  EXPECT_FALSE(settings.allow_ads);
+  EXPECT_FALSE(settings.allow_http_upgradable_resource);
+  EXPECT_TRUE(cache->Get(other_url).shields_enabled);
+  EXPECT_EQ(cache->size_for_testing(), 2u);
+
+  // Content settings that aren't shields settings keep the cache.
+  map()->SetContentSettingDefaultScope(url, GURL(),
+                                       ContentSettingsType::JAVASCRIPT,
+                                       CONTENT_SETTING_BLOCK);
+  EXPECT_EQ(cache->size_for_testing(), 2u);
+
+  brave_shields::SetBraveShieldsEnabled(map(), false, url);
+  EXPECT_EQ(cache->size_for_testing(), 0u);
+  EXPECT_FALSE(cache->Get(url).shields_enabled);
+  EXPECT_TRUE(cache->Get(other_url).shields_enabled);
+
+  brave_shields::SetAdControlType(map(), ControlType::ALLOW, url);
+  EXPECT_TRUE(cache->Get(url).allow_ads);
+  EXPECT_FALSE(cache->Get(other_url).allow_ads);
+
+  brave_shields::SetHTTPSEverywhereEnabled(map(), false, url);
+  EXPECT_TRUE(cache->Get(url).allow_http_upgradable_resource);
+
+  brave_shields::SetCosmeticFilteringControlType(map(), ControlType::BLOCK,
+                                                 url);
+  EXPECT_TRUE(cache->Get(url).aggressive_blocking);
+  EXPECT_FALSE(cache->Get(other_url).aggressive_blocking);
+}
+
+TEST_F(ShieldsSettingsCacheTest, EvictsLeastRecentlyUsedOrigins) {
+  auto* cache = ShieldsSettingsCache::GetForBrowserContext(profile());
+  const GURL url("https://brave.com/");
+  brave_shields::SetBraveShieldsEnabled(map(), false, url);
+  EXPECT_FALSE(cache->Get(url).shields_enabled);
+
+  for (size_t i = 0; i < 2000; ++i) {
+    cache->Get(GURL(base::StringPrintf("https://site%zu.example.com/", i)));
+    // Keep |url| the most recently used origin.
+    cache->Get(url);
+  }
+  EXPECT_EQ(cache->size_for_testing(), 1000u);
+  EXPECT_FALSE(cache->Get(url).shields_enabled);
+}
+
+// Loads pages with many subresources while the profile has a few hundred
+// site exceptions, as accumulated by users toggling shields per site.
+TEST_F(ShieldsSettingsCacheTest, MakeCTXWithSiteExceptions) {
+  constexpr size_t kExceptions = 500;
+  constexpr size_t kPages = 20;
+  constexpr size_t kSubresourcesPerPage = 100;
+  for (size_t i = 0; i < kExceptions; ++i) {
+    const GURL url(base::StringPrintf("https://site%zu.example.com/", i));
+    switch (i % 3) {
+      case 0:
+        brave_shields::SetBraveShieldsEnabled(map(), false, url);
+        break;
+      case 1:
+        brave_shields::SetAdControlType(map(), ControlType::ALLOW, url);
+        break;
+      case 2:
+        brave_shields::SetHTTPSEverywhereEnabled(map(), false, url);
+        break;
+    }
+  }
+
+  std::vector<network::ResourceRequest> requests;
+  for (size_t page = 0; page < kPages; ++page) {
+    const url::Origin top_frame_origin = url::Origin::Create(
+        GURL(base::StringPrintf("https://site%zu.example.com/", page)));
+    for (size_t i = 0; i < kSubresourcesPerPage; ++i) {
+      network::ResourceRequest request;
+      request.method = "GET";
+      request.url =
+          GURL(base::StringPrintf("https://cdn%zu.example.net/%zu.js", i, i));
+      request.trusted_params = network::ResourceRequest::TrustedParams();
+      request.trusted_params->isolation_info =
+          net::IsolationInfo::CreateForInternalRequest(top_frame_origin);
+      requests.push_back(std::move(request));
+    }
+  }
+
+  // What MakeCTX did for every request before the cache existed.
+  base::ElapsedTimer uncached_timer;
+  std::vector<ShieldsSettings> uncached_settings;
+  for (const auto& request : requests) {
+    const GURL tab_origin =
+        request.trusted_params->isolation_info.top_frame_origin()->GetURL();
+    ShieldsSettings settings;
+    settings.shields_enabled =
+        brave_shields::GetBraveShieldsEnabled(map(), tab_origin);
+    settings.allow_ads = brave_shields::GetAdControlType(map(), tab_origin) ==
+                         ControlType::ALLOW;
+    settings.aggressive_blocking =
+        brave_shields::GetCosmeticFilteringControlType(map(), tab_origin) ==
+        ControlType::BLOCK;
+    settings.allow_http_upgradable_resource =
+        !brave_shields::GetHTTPSEverywhereEnabled(map(), tab_origin);
+    settings.allow_referrers = brave_shields::AllowReferrers(map(), tab_origin);
+    uncached_settings.push_back(settings);
+  }
+  const base::TimeDelta uncached = uncached_timer.Elapsed();
+
+  base::ElapsedTimer make_ctx_timer;
+  std::vector<std::shared_ptr<BraveRequestInfo>> ctxs;
+  uint64_t request_identifier = 0;
+  for (const auto& request : requests) {
+    ctxs.push_back(BraveRequestInfo::MakeCTX(
+        request, 0, 0, ++request_identifier, profile(), nullptr));
+  }
+  const base::TimeDelta make_ctx = make_ctx_timer.Elapsed();
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const size_t page = i / kSubresourcesPerPage;
+    EXPECT_EQ(ctxs[i]->allow_brave_shields, page % 3 != 0);
+    EXPECT_EQ(ctxs[i]->allow_ads, page % 3 == 1);
+    EXPECT_EQ(ctxs[i]->allow_http_upgradable_resource, page % 3 == 2);
+
+    EXPECT_EQ(ctxs[i]->allow_brave_shields,
+              uncached_settings[i].shields_enabled);
+    EXPECT_EQ(ctxs[i]->allow_ads, uncached_settings[i].allow_ads);
+    EXPECT_EQ(ctxs[i]->aggressive_blocking,
+              uncached_settings[i].aggressive_blocking);
+    EXPECT_EQ(ctxs[i]->allow_http_upgradable_resource,
+              uncached_settings[i].allow_http_upgradable_resource);
+    EXPECT_EQ(ctxs[i]->allow_referrers, uncached_settings[i].allow_referrers);
+  }
+  EXPECT_EQ(
+      ShieldsSettingsCache::GetForBrowserContext(profile())->size_for_testing(),
+      kPages);
+
+  VLOG(1) << requests.size() << " requests, " << kExceptions
+          << " site exceptions. Uncached settings lookups: " << uncached
+          << ", MakeCTX: " << make_ctx;
+}
+
+}  // namespace brave
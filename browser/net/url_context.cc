@@ -9,12 +9,10 @@
 #include <string>
 
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
-#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/browser/net/shields_settings_cache.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
-#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
-#include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/render_frame_host.h"
 #include "net/base/isolation_info.h"
@@ -32,14 +30,18 @@
 
 namespace brave {
 
-namespace {
+BraveRequestInfo::BraveRequestInfo() = default;
 
-std::string GetUploadData(const network::ResourceRequest& request) {
-  std::string upload_data;
-  if (!request.request_body) {
+BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
+
+BraveRequestInfo::~BraveRequestInfo() = default;
+
+std::string BraveRequestInfo::GetUploadData() const {
+  if (!request_body) {
     return {};
   }
-  const auto* elements = request.request_body->elements();
+  std::string upload_data;
+  const auto* elements = request_body->elements();
   for (const network::DataElement& element : *elements) {
     if (element.type() == network::mojom::DataElementDataView::Tag::kBytes) {
       const auto& bytes = element.As<network::DataElementBytes>().bytes();
@@ -50,14 +52,6 @@ std::string GetUploadData(const network::ResourceRequest& request) {
   return upload_data;
 }
 
-}  // namespace
-
-BraveRequestInfo::BraveRequestInfo() = default;
-
-BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
-
-BraveRequestInfo::~BraveRequestInfo() = default;
-
 // static
 std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
     const network::ResourceRequest& request,
@@ -136,28 +130,25 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
   }
 #endif
 
-  Profile* profile = Profile::FromBrowserContext(browser_context);
-  auto* map = HostContentSettingsMapFactory::GetForProfile(profile);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(map, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(map, ctx->tab_origin) ==
-                   brave_shields::ControlType::ALLOW;
-  // Currently, "aggressive" mode is registered as a cosmetic filtering control
-  // type, even though it can also affect network blocking.
-  ctx->aggressive_blocking =
-      brave_shields::GetCosmeticFilteringControlType(map, ctx->tab_origin) ==
-      brave_shields::ControlType::BLOCK;
+  auto* shields_settings_cache =
+      ShieldsSettingsCache::GetForBrowserContext(browser_context);
+  const ShieldsSettings shields_settings =
+      shields_settings_cache->Get(ctx->tab_origin);
+  ctx->allow_brave_shields = shields_settings.shields_enabled;
+  ctx->allow_ads = shields_settings.allow_ads;
+  ctx->aggressive_blocking = shields_settings.aggressive_blocking;
   ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(map, ctx->tab_origin);
+      shields_settings.allow_http_upgradable_resource;
 
   // HACK: after we fix multiple creations of BraveRequestInfo we should
   // use only tab_origin. Since we recreate BraveRequestInfo during consequent
   // stages of navigation, |tab_origin| changes and so does |allow_referrers|
   // flag, which is not what we want for determining referrers.
-  ctx->allow_referrers = brave_shields::AllowReferrers(
-      map,
-      ctx->redirect_source.is_empty() ? ctx->tab_origin : ctx->redirect_source);
-  ctx->upload_data = GetUploadData(request);
+  ctx->allow_referrers =
+      ctx->redirect_source.is_empty()
+          ? shields_settings.allow_referrers
+          : shields_settings_cache->Get(ctx->redirect_source).allow_referrers;
+  ctx->request_body = request.request_body;
 
   ctx->browser_context = browser_context;
 
@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 
+#include "base/memory/scoped_refptr.h"
 #include "net/base/network_isolation_key.h"
 #include "net/http/http_request_headers.h"
 #include "net/http/http_response_headers.h"
@@ -25,6 +26,7 @@ class BrowserContext;
 }
 
 namespace network {
+class ResourceRequestBody;
 struct ResourceRequest;
 }
 
@@ -118,7 +120,13 @@ struct BraveRequestInfo {
       static_cast<blink::mojom::ResourceType>(-1);
   blink::mojom::ResourceType resource_type = kInvalidResourceType;
 
-  std::string upload_data;
+  // Shares the body of the request, see GetUploadData().
+  scoped_refptr<network::ResourceRequestBody> request_body;
+
+  // Concatenates the in-memory elements of |request_body|. Bodies can be
+  // several megabytes and few handlers look at them, so they are copied only
+  // when asked for.
+  std::string GetUploadData() const;
 
   static std::shared_ptr<brave::BraveRequestInfo> MakeCTX(
       const network::ResourceRequest& request,
@@ -137,19 +145,22 @@ struct BraveRequestInfo {
 };
 
 // ResponseListener
+// Stages run in order by BraveRequestHandler for each event. A stage returns
+// net::ERR_IO_PENDING and runs |next_callback| once done to suspend the
+// pipeline, any other result lets the next stage run inline.
 using OnBeforeURLRequestCallback =
-    base::RepeatingCallback<int(const ResponseCallback& next_callback,
-                                std::shared_ptr<BraveRequestInfo> ctx)>;
+    int (*)(const ResponseCallback& next_callback,
+            std::shared_ptr<BraveRequestInfo> ctx);
 using OnBeforeStartTransactionCallback =
-    base::RepeatingCallback<int(net::HttpRequestHeaders* headers,
-                                const ResponseCallback& next_callback,
-                                std::shared_ptr<BraveRequestInfo> ctx)>;
-using OnHeadersReceivedCallback = base::RepeatingCallback<int(
+    int (*)(net::HttpRequestHeaders* headers,
+            const ResponseCallback& next_callback,
+            std::shared_ptr<BraveRequestInfo> ctx);
+using OnHeadersReceivedCallback = int (*)(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url,
     const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx)>;
+    std::shared_ptr<BraveRequestInfo> ctx);
 
 }  // namespace brave
 
@@ -0,0 +1,70 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_context.h"
+
+#include <memory>
+#include <string>
+
+#include "base/logging.h"
+#include "base/memory/scoped_refptr.h"
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/resource_request_body.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+class BraveRequestInfoTest : public testing::Test {
+ public:
+  BraveRequestInfoTest() = default;
+  ~BraveRequestInfoTest() override = default;
+
+  void SetUp() override { profile_ = std::make_unique<TestingProfile>(); }
+
+  void TearDown() override { profile_.reset(); }
+
+  TestingProfile* profile() { return profile_.get(); }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+};
+
+TEST_F(BraveRequestInfoTest, UploadDataIsSharedUntilRequested) {
+  constexpr size_t kChunkSize = 4 * 1024 * 1024;
+  const std::string chunk(kChunkSize, 'a');
+  network::ResourceRequest request;
+  request.method = "POST";
+  request.url = GURL("https://upload.example.com/");
+  request.request_body = base::MakeRefCounted<network::ResourceRequestBody>();
+  request.request_body->AppendBytes(chunk.data(), chunk.size());
+  request.request_body->AppendBytes(chunk.data(), chunk.size());
+
+  // BraveRequestInfo is rebuilt at each stage of a request, all of them share
+  // the body instead of holding an 8MB copy each.
+  std::shared_ptr<BraveRequestInfo> ctx;
+  for (int stage = 0; stage < 3; ++stage) {
+    ctx = BraveRequestInfo::MakeCTX(request, 0, 0, 1, profile(), ctx);
+    EXPECT_EQ(ctx->request_body.get(), request.request_body.get());
+  }
+
+  // The body is only copied for handlers asking for it.
+  const std::string upload_data = ctx->GetUploadData();
+  EXPECT_EQ(upload_data.size(), 2 * kChunkSize);
+  EXPECT_EQ(upload_data, chunk + chunk);
+  VLOG(1) << "Bytes copied building 3 contexts: 0 (was " << 3 * 2 * kChunkSize
+          << "), bytes copied for a handler reading the body: "
+          << upload_data.size();
+
+  request.request_body = nullptr;
+  ctx = BraveRequestInfo::MakeCTX(request, 0, 0, 2, profile(), nullptr);
+  EXPECT_FALSE(ctx->request_body);
+  EXPECT_TRUE(ctx->GetUploadData().empty());
+}
+
+}  // namespace brave
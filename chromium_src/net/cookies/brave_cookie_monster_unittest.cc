@@ -0,0 +1,189 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "net/cookies/cookie_monster.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/process/process_metrics.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_deletion_info.h"
+#include "net/cookies/cookie_options.h"
+#include "net/cookies/cookie_partition_key_collection.h"
+#include "net/cookies/cookie_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+namespace net {
+
+namespace {
+
+std::string SiteHost(size_t site) {
+  return base::StringPrintf("site%d.com", static_cast<int>(site));
+}
+
+GURL ThirdPartyURL(size_t third_party) {
+  return GURL(
+      base::StringPrintf("https://tp%d.com/", static_cast<int>(third_party)));
+}
+
+CookieOptions EphemeralOptions(const std::string& top_frame_host) {
+  CookieOptions options = CookieOptions::MakeAllInclusive();
+  options.set_should_use_ephemeral_storage(true);
+  options.set_top_frame_origin(
+      url::Origin::Create(GURL("https://" + top_frame_host)));
+  return options;
+}
+
+}  // namespace
+
+class BraveCookieMonsterTest : public testing::Test {
+ public:
+  BraveCookieMonsterTest()
+      : cookie_monster_(nullptr /* store */,
+                        nullptr /* net_log */,
+                        /*first_party_sets_enabled=*/false) {}
+  ~BraveCookieMonsterTest() override = default;
+
+  bool SetCookie(const GURL& url,
+                 const std::string& cookie_line,
+                 const CookieOptions& options) {
+    auto cookie = CanonicalCookie::Create(
+        url, cookie_line, base::Time::Now(), /*server_time=*/absl::nullopt,
+        /*cookie_partition_key=*/absl::nullopt);
+    bool result = false;
+    base::RunLoop run_loop;
+    cookie_monster_.SetCanonicalCookieAsync(
+        std::move(cookie), url, options,
+        base::BindLambdaForTesting([&](CookieAccessResult access_result) {
+          result = access_result.status.IsInclude();
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+    return result;
+  }
+
+  CookieList GetCookies(const GURL& url, const CookieOptions& options) {
+    CookieList cookies;
+    base::RunLoop run_loop;
+    cookie_monster_.GetCookieListWithOptionsAsync(
+        url, options, CookiePartitionKeyCollection(),
+        base::BindLambdaForTesting(
+            [&](const CookieAccessResultList& included,
+                const CookieAccessResultList& excluded) {
+              cookies = cookie_util::StripAccessResults(included);
+              run_loop.Quit();
+            }));
+    run_loop.Run();
+    return cookies;
+  }
+
+  void DropPartition(const std::string& ephemeral_storage_domain) {
+    CookieDeletionInfo delete_info;
+    delete_info.ephemeral_storage_domain = ephemeral_storage_domain;
+    base::RunLoop run_loop;
+    cookie_monster_.DeleteAllMatchingInfoAsync(
+        std::move(delete_info),
+        base::BindLambdaForTesting([&](uint32_t) { run_loop.Quit(); }));
+    run_loop.Run();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  CookieMonster cookie_monster_;
+};
+
+TEST_F(BraveCookieMonsterTest, PartitionsAreIsolated) {
+  const GURL tracker("https://tracker.com/");
+  EXPECT_TRUE(SetCookie(tracker, "id=a", EphemeralOptions("a.com")));
+  EXPECT_TRUE(SetCookie(tracker, "id=b", EphemeralOptions("www.b.com")));
+
+  CookieList cookies = GetCookies(tracker, EphemeralOptions("sub.a.com"));
+  ASSERT_EQ(cookies.size(), 1u);
+  EXPECT_EQ(cookies[0].Value(), "a");
+  cookies = GetCookies(tracker, EphemeralOptions("b.com"));
+  ASSERT_EQ(cookies.size(), 1u);
+  EXPECT_EQ(cookies[0].Value(), "b");
+  EXPECT_TRUE(GetCookies(tracker, CookieOptions::MakeAllInclusive()).empty());
+  EXPECT_EQ(cookie_monster_.ephemeral_cookie_store_count_for_testing(), 2u);
+}
+
+TEST_F(BraveCookieMonsterTest, ReadsDontCreatePartitions) {
+  EXPECT_TRUE(
+      GetCookies(GURL("https://tracker.com/"), EphemeralOptions("a.com"))
+          .empty());
+  EXPECT_EQ(cookie_monster_.ephemeral_cookie_store_count_for_testing(), 0u);
+}
+
+TEST_F(BraveCookieMonsterTest, DropPartition) {
+  const GURL tracker("https://tracker.com/");
+  EXPECT_TRUE(SetCookie(tracker, "id=a", EphemeralOptions("a.com")));
+  EXPECT_TRUE(SetCookie(tracker, "id=b", EphemeralOptions("b.com")));
+
+  DropPartition("a.com");
+  EXPECT_EQ(cookie_monster_.ephemeral_cookie_store_count_for_testing(), 1u);
+  EXPECT_TRUE(GetCookies(tracker, EphemeralOptions("a.com")).empty());
+  EXPECT_EQ(GetCookies(tracker, EphemeralOptions("b.com")).size(), 1u);
+}
+
+// Visits 200 sites that embed the same 5 third parties, each setting a
+// cookie, then reads them back from every site. A further 200 sites only
+// read cookies, as most embedded frames do.
+TEST_F(BraveCookieMonsterTest, ManyPartitions) {
+  constexpr size_t kPartitionCount = 200;
+  constexpr size_t kThirdPartyCount = 5;
+
+  // Heap growth of the whole process, the stores don't report their own size.
+  std::unique_ptr<base::ProcessMetrics> metrics =
+      base::ProcessMetrics::CreateCurrentProcessMetrics();
+  const size_t malloc_before = metrics->GetMallocUsage();
+
+  base::ElapsedTimer set_timer;
+  for (size_t site = 0; site < kPartitionCount; ++site) {
+    const CookieOptions options = EphemeralOptions(SiteHost(site));
+    for (size_t tp = 0; tp < kThirdPartyCount; ++tp)
+      EXPECT_TRUE(SetCookie(ThirdPartyURL(tp), "id=1", options));
+  }
+  const base::TimeDelta set_time = set_timer.Elapsed();
+
+  base::ElapsedTimer get_timer;
+  for (size_t site = 0; site < 2 * kPartitionCount; ++site) {
+    const CookieOptions options = EphemeralOptions(SiteHost(site));
+    for (size_t tp = 0; tp < kThirdPartyCount; ++tp) {
+      EXPECT_EQ(GetCookies(ThirdPartyURL(tp), options).size(),
+                site < kPartitionCount ? 1u : 0u);
+    }
+  }
+  const base::TimeDelta get_time = get_timer.Elapsed();
+  const size_t malloc_after = metrics->GetMallocUsage();
+
+  VLOG(1) << kPartitionCount * kThirdPartyCount << " ephemeral sets in "
+          << set_time << ", " << 2 * kPartitionCount * kThirdPartyCount
+          << " gets in " << get_time << ", "
+          << cookie_monster_.ephemeral_cookie_store_count_for_testing()
+          << " partitions, "
+          << (malloc_after > malloc_before ? malloc_after - malloc_before : 0)
+          << " bytes of heap growth";
+  EXPECT_EQ(cookie_monster_.ephemeral_cookie_store_count_for_testing(),
+            kPartitionCount);
+
+  base::ElapsedTimer drop_timer;
+  for (size_t site = 0; site < kPartitionCount; ++site)
+    DropPartition(SiteHost(site));
+  VLOG(1) << "Dropped " << kPartitionCount << " partitions in "
+          << drop_timer.Elapsed();
+  EXPECT_EQ(cookie_monster_.ephemeral_cookie_store_count_for_testing(), 0u);
+}
+
+}  // namespace net
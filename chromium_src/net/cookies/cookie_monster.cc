@@ -6,6 +6,7 @@
 #include "net/cookies/cookie_monster.h"
 
 #include <memory>
+
 #include "net/base/url_util.h"
 
 #define CookieMonster ChromiumCookieMonster
@@ -34,19 +35,28 @@ CookieMonster::CookieMonster(scoped_refptr<PersistentCookieStore> store,
 
 CookieMonster::~CookieMonster() {}
 
+ChromiumCookieMonster* CookieMonster::GetEphemeralCookieStoreForTopFrameURL(
+    const GURL& top_frame_url) {
+  auto it =
+      ephemeral_cookie_stores_.find(URLToEphemeralStorageDomain(top_frame_url));
+  return it != ephemeral_cookie_stores_.end() ? it->second.get() : nullptr;
+}
+
 ChromiumCookieMonster*
 CookieMonster::GetOrCreateEphemeralCookieStoreForTopFrameURL(
     const GURL& top_frame_url) {
-  std::string domain = URLToEphemeralStorageDomain(top_frame_url);
-  auto it = ephemeral_cookie_stores_.find(domain);
-  if (it != ephemeral_cookie_stores_.end())
-    return it->second.get();
-
-  return ephemeral_cookie_stores_
-      .emplace(domain, new ChromiumCookieMonster(
-                           nullptr /* store */, net_log_.net_log(),
-                           /*first_party_sets_enabled=*/false))
-      .first->second.get();
+  auto& store =
+      ephemeral_cookie_stores_[URLToEphemeralStorageDomain(top_frame_url)];
+  if (!store) {
+    store = std::make_unique<ChromiumCookieMonster>(
+        nullptr /* store */, net_log_.net_log(),
+        /*first_party_sets_enabled=*/false);
+    if (ephemeral_cookieable_schemes_) {
+      store->SetCookieableSchemes(*ephemeral_cookieable_schemes_,
+                                  SetCookieableSchemesCallback());
+    }
+  }
+  return store.get();
 }
 
 void CookieMonster::DeleteCanonicalCookieAsync(const CanonicalCookie& cookie,
@@ -94,6 +104,7 @@ void CookieMonster::DeleteSessionCookiesAsync(DeleteCallback callback) {
 void CookieMonster::SetCookieableSchemes(
     const std::vector<std::string>& schemes,
     SetCookieableSchemesCallback callback) {
+  ephemeral_cookieable_schemes_ = schemes;
   for (auto& it : ephemeral_cookie_stores_) {
     it.second->SetCookieableSchemes(schemes, SetCookieableSchemesCallback());
   }
@@ -144,8 +155,13 @@ void CookieMonster::GetCookieListWithOptionsAsync(
       return;
     }
     ChromiumCookieMonster* ephemeral_monster =
-        GetOrCreateEphemeralCookieStoreForTopFrameURL(
+        GetEphemeralCookieStoreForTopFrameURL(
             options.top_frame_origin()->GetURL());
+    if (!ephemeral_monster) {
+      MaybeRunCookieCallback(std::move(callback), CookieAccessResultList(),
+                             CookieAccessResultList());
+      return;
+    }
     ephemeral_monster->GetCookieListWithOptionsAsync(
         url, options, cookie_partition_key_collection, std::move(callback));
     return;
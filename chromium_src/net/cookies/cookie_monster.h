@@ -6,6 +6,12 @@
 #ifndef BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_MONSTER_H_
 #define BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_MONSTER_H_
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
 #define CookieMonster ChromiumCookieMonster
 #include "src/net/cookies/cookie_monster.h"
 #undef CookieMonster
@@ -52,12 +58,26 @@ class NET_EXPORT CookieMonster : public ChromiumCookieMonster {
       const CookiePartitionKeyCollection& cookie_partition_key_collection,
       GetCookieListCallback callback) override;
 
+  size_t ephemeral_cookie_store_count_for_testing() const {
+    return ephemeral_cookie_stores_.size();
+  }
+
  private:
-  NetLogWithSource net_log_;
-  std::map<std::string, std::unique_ptr<ChromiumCookieMonster>>
-      ephemeral_cookie_stores_;
+  // Returns nullptr if nothing was ever set for |top_frame_url|, reads don't
+  // create a partition.
+  ChromiumCookieMonster* GetEphemeralCookieStoreForTopFrameURL(
+      const GURL& top_frame_url);
   ChromiumCookieMonster* GetOrCreateEphemeralCookieStoreForTopFrameURL(
       const GURL& top_frame_url);
+
+  NetLogWithSource net_log_;
+  // One partition per ephemeral storage domain, hashed so that dropping a
+  // partition when its ephemeral lifetime ends doesn't depend on how many
+  // third-party-heavy sites are open.
+  std::unordered_map<std::string, std::unique_ptr<ChromiumCookieMonster>>
+      ephemeral_cookie_stores_;
+  // Applied to partitions created after SetCookieableSchemes().
+  absl::optional<std::vector<std::string>> ephemeral_cookieable_schemes_;
 };
 
 }  // namespace net
@@ -5,9 +5,13 @@
 
 #include "brave/components/api_request_helper/api_request_helper.h"
 
+#include <iterator>
 #include <utility>
 
+#include "base/strings/string_number_conversions.h"
 #include "net/base/load_flags.h"
+#include "net/base/request_priority.h"
+#include "services/data_decoder/public/cpp/data_decoder.h"
 #include "services/data_decoder/public/cpp/json_sanitizer.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
@@ -36,10 +40,100 @@ void OnSanitize(const int http_code,
   std::move(result_callback).Run(http_code, response_body, headers);
 }
 
+void OnParseJson(const int http_code,
+                 const base::flat_map<std::string, std::string>& headers,
+                 APIRequestHelper::ValueResultCallback result_callback,
+                 data_decoder::DataDecoder::ValueOrError result) {
+  if (!result.value) {
+    VLOG(1) << "Response validation error:" << *result.error;
+    std::move(result_callback).Run(http_code, base::Value(), headers);
+    return;
+  }
+
+  std::move(result_callback).Run(http_code, std::move(*result.value), headers);
+}
+
+// Returns false if |conversion_callback| rejected the response.
+bool MaybeConvertResponse(
+    APIRequestHelper::ResponseConversionCallback conversion_callback,
+    std::string* response_body) {
+  if (!conversion_callback)
+    return true;
+  auto converted_body = std::move(conversion_callback).Run(*response_body);
+  if (!converted_body)
+    return false;
+  *response_body = std::move(converted_body.value());
+  return true;
+}
+
+void OnResponse(APIRequestHelper::ResultCallback callback,
+                APIRequestHelper::ResponseConversionCallback
+                    conversion_callback,
+                const int response_code,
+                std::unique_ptr<std::string> response_body,
+                base::flat_map<std::string, std::string> headers) {
+  if (!response_body) {
+    std::move(callback).Run(response_code, "", headers);
+    return;
+  }
+  auto& raw_body = *response_body;
+  if (!MaybeConvertResponse(std::move(conversion_callback), &raw_body)) {
+    std::move(callback).Run(422, raw_body, headers);
+    return;
+  }
+
+  data_decoder::JsonSanitizer::Sanitize(
+      std::move(raw_body),
+      base::BindOnce(&OnSanitize, response_code, std::move(headers),
+                     std::move(callback)));
+}
+
+void OnJsonResponse(APIRequestHelper::ValueResultCallback callback,
+                    APIRequestHelper::ResponseConversionCallback
+                        conversion_callback,
+                    const int response_code,
+                    std::unique_ptr<std::string> response_body,
+                    base::flat_map<std::string, std::string> headers) {
+  if (!response_body) {
+    std::move(callback).Run(response_code, base::Value(), headers);
+    return;
+  }
+  if (!MaybeConvertResponse(std::move(conversion_callback),
+                            response_body.get())) {
+    std::move(callback).Run(422, base::Value(), headers);
+    return;
+  }
+
+  data_decoder::DataDecoder::ParseJsonIsolated(
+      *response_body, base::BindOnce(&OnParseJson, response_code,
+                                     std::move(headers), std::move(callback)));
+}
+
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// Requests with the same key get the same response, so only one of them is
+// sent. Requests with side effects are never shared.
+std::string GetCoalescingKey(
+    const std::string& method,
+    const GURL& url,
+    bool auto_retry_on_network_change,
+    const base::flat_map<std::string, std::string>& headers,
+    size_t max_body_size) {
+  if (method != "GET" && method != "HEAD")
+    return std::string();
+  std::string key = method + " " + url.spec() + " " +
+                    base::NumberToString(max_body_size) +
+                    (auto_retry_on_network_change ? " retry" : " no-retry");
+  for (const auto& header : headers)
+    key += "\n" + header.first + ": " + header.second;
+  return key;
+}
+
 }  // namespace
 
+APIRequestHelper::Job::Job() = default;
+APIRequestHelper::Job::~Job() = default;
+
 APIRequestHelper::APIRequestHelper(
     net::NetworkTrafficAnnotationTag annotation_tag,
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
@@ -57,7 +151,54 @@ void APIRequestHelper::Request(
     ResultCallback callback,
     const base::flat_map<std::string, std::string>& headers,
     size_t max_body_size /* = -1u */,
-    ResponseConversionCallback conversion_callback) {
+    ResponseConversionCallback conversion_callback,
+    Priority priority) {
+  Download(method, url, payload, payload_content_type,
+           auto_retry_on_network_change, headers, max_body_size, priority,
+           base::BindOnce(&OnResponse, std::move(callback),
+                          std::move(conversion_callback)));
+}
+
+void APIRequestHelper::RequestJson(
+    const std::string& method,
+    const GURL& url,
+    const std::string& payload,
+    const std::string& payload_content_type,
+    bool auto_retry_on_network_change,
+    ValueResultCallback callback,
+    const base::flat_map<std::string, std::string>& headers,
+    size_t max_body_size /* = -1u */,
+    ResponseConversionCallback conversion_callback,
+    Priority priority) {
+  Download(method, url, payload, payload_content_type,
+           auto_retry_on_network_change, headers, max_body_size, priority,
+           base::BindOnce(&OnJsonResponse, std::move(callback),
+                          std::move(conversion_callback)));
+}
+
+void APIRequestHelper::Download(
+    const std::string& method,
+    const GURL& url,
+    const std::string& payload,
+    const std::string& payload_content_type,
+    bool auto_retry_on_network_change,
+    const base::flat_map<std::string, std::string>& headers,
+    size_t max_body_size,
+    Priority priority,
+    DownloadCallback callback) {
+  std::string coalescing_key = GetCoalescingKey(
+      method, url, auto_retry_on_network_change, headers, max_body_size);
+  if (!coalescing_key.empty()) {
+    auto existing = coalescable_jobs_.find(coalescing_key);
+    if (existing != coalescable_jobs_.end()) {
+      Job* job = existing->second;
+      job->callbacks.push_back(std::move(callback));
+      if (priority < job->priority)
+        job->priority = priority;
+      return;
+    }
+  }
+
   auto request = std::make_unique<network::ResourceRequest>();
   request->url = url;
   request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE |
@@ -70,40 +211,99 @@ void APIRequestHelper::Request(
       request->headers.SetHeader(entry.first, entry.second);
   }
 
-  auto url_loader =
-      network::SimpleURLLoader::Create(std::move(request), annotation_tag_);
-  if (!payload.empty()) {
-    url_loader->AttachStringForUpload(payload, payload_content_type);
+  auto job = std::make_unique<Job>();
+  job->request = std::move(request);
+  job->payload = payload;
+  job->payload_content_type = payload_content_type;
+  job->auto_retry_on_network_change = auto_retry_on_network_change;
+  job->max_body_size = max_body_size;
+  job->priority = priority;
+  job->host = url.host();
+  job->coalescing_key = std::move(coalescing_key);
+  job->callbacks.push_back(std::move(callback));
+  if (!job->coalescing_key.empty())
+    coalescable_jobs_[job->coalescing_key] = job.get();
+  queued_jobs_.push_back(std::move(job));
+
+  MaybeStartJobs();
+}
+
+void APIRequestHelper::MaybeStartJobs() {
+  for (auto next = PickNextJob(); next != queued_jobs_.end();
+       next = PickNextJob()) {
+    StartJob(next);
+  }
+}
+
+// The earliest job of the highest queued priority whose host has room for
+// another download, so that a burst of requests to one host doesn't hold up
+// the others.
+APIRequestHelper::JobList::iterator APIRequestHelper::PickNextJob() {
+  auto next = queued_jobs_.end();
+  for (auto iter = queued_jobs_.begin(); iter != queued_jobs_.end(); ++iter) {
+    const Job& job = **iter;
+    if (next != queued_jobs_.end() && job.priority >= (*next)->priority)
+      continue;
+    if (max_requests_per_host_) {
+      auto running = running_jobs_per_host_.find(job.host);
+      if (running != running_jobs_per_host_.end() &&
+          running->second >= max_requests_per_host_) {
+        continue;
+      }
+    }
+    next = iter;
+    if (job.priority == Priority::kInteractive)
+      break;
+  }
+  return next;
+}
+
+void APIRequestHelper::StartJob(JobList::iterator queued_iter) {
+  running_jobs_.splice(running_jobs_.end(), queued_jobs_, queued_iter);
+  auto iter = std::prev(running_jobs_.end());
+  Job* job = iter->get();
+  ++running_jobs_per_host_[job->host];
+
+  job->request->priority =
+      job->priority == Priority::kInteractive ? net::MEDIUM : net::IDLE;
+  job->url_loader = network::SimpleURLLoader::Create(std::move(job->request),
+                                                     annotation_tag_);
+  auto* url_loader = job->url_loader.get();
+  if (!job->payload.empty()) {
+    url_loader->AttachStringForUpload(job->payload, job->payload_content_type);
   }
   url_loader->SetRetryOptions(
       kRetriesCountOnNetworkChange,
-      auto_retry_on_network_change
+      job->auto_retry_on_network_change
           ? network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE
           : network::SimpleURLLoader::RetryMode::RETRY_NEVER);
   url_loader->SetAllowHttpErrorResults(true);
-  auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
-  if (max_body_size == -1u) {
-    iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+  if (job->max_body_size == -1u) {
+    url_loader->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
         url_loader_factory_.get(),
-        base::BindOnce(&APIRequestHelper::OnResponse,
-                       weak_ptr_factory_.GetWeakPtr(), iter,
-                       std::move(callback), std::move(conversion_callback)));
+        base::BindOnce(&APIRequestHelper::OnDownload,
+                       weak_ptr_factory_.GetWeakPtr(), iter));
   } else {
-    iter->get()->DownloadToString(
+    url_loader->DownloadToString(
         url_loader_factory_.get(),
-        base::BindOnce(&APIRequestHelper::OnResponse,
-                       weak_ptr_factory_.GetWeakPtr(), iter,
-                       std::move(callback), std::move(conversion_callback)),
-        max_body_size);
+        base::BindOnce(&APIRequestHelper::OnDownload,
+                       weak_ptr_factory_.GetWeakPtr(), iter),
+        job->max_body_size);
   }
 }
 
-void APIRequestHelper::OnResponse(
-    SimpleURLLoaderList::iterator iter,
-    ResultCallback callback,
-    ResponseConversionCallback conversion_callback,
-    const std::unique_ptr<std::string> response_body) {
-  auto* loader = iter->get();
+void APIRequestHelper::OnDownload(JobList::iterator iter,
+                                  std::unique_ptr<std::string> response_body) {
+  std::unique_ptr<Job> job = std::move(*iter);
+  running_jobs_.erase(iter);
+  auto running = running_jobs_per_host_.find(job->host);
+  DCHECK(running != running_jobs_per_host_.end());
+  if (--running->second == 0)
+    running_jobs_per_host_.erase(running);
+  if (!job->coalescing_key.empty())
+    coalescable_jobs_.erase(job->coalescing_key);
+
+  auto* loader = job->url_loader.get();
   auto response_code = -1;
   base::flat_map<std::string, std::string> headers;
   if (loader->ResponseInfo()) {
@@ -120,25 +320,19 @@ void APIRequestHelper::OnResponse(
     }
   }
 
-  url_loaders_.erase(iter);
-  if (!response_body) {
-    std::move(callback).Run(response_code, "", headers);
-    return;
-  }
-  auto& raw_body = *response_body;
-  if (conversion_callback) {
-    auto converted_body = std::move(conversion_callback).Run(raw_body);
-    if (!converted_body) {
-      std::move(callback).Run(422, raw_body, headers);
-      return;
-    }
-    raw_body = converted_body.value();
-  }
+  MaybeStartJobs();
 
-  data_decoder::JsonSanitizer::Sanitize(
-      std::move(raw_body),
-      base::BindOnce(&OnSanitize, response_code, std::move(headers),
-                     std::move(callback)));
+  // Nothing below may touch |this|, any of the callbacks can delete it.
+  auto& callbacks = job->callbacks;
+  for (size_t i = 0; i + 1 < callbacks.size(); ++i) {
+    std::move(callbacks[i])
+        .Run(response_code,
+             response_body ? std::make_unique<std::string>(*response_body)
+                           : nullptr,
+             headers);
+  }
+  std::move(callbacks.back())
+      .Run(response_code, std::move(response_body), std::move(headers));
 }
 
 }  // namespace api_request_helper
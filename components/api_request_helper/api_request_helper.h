@@ -9,15 +9,20 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/callback_helpers.h"
+#include "base/check_op.h"
 #include "base/containers/flat_map.h"
+#include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace network {
+struct ResourceRequest;
 class SharedURLLoaderFactory;
 class SimpleURLLoader;
 }  // namespace network
@@ -25,8 +30,26 @@ class SimpleURLLoader;
 namespace api_request_helper {
 
 // Anyone is welcome to use APIRequestHelper to reduce boilerplate
+//
+// Requests are scheduled per helper: identical GET/HEAD requests share a
+// single download and, for helpers that cap the requests running per host,
+// queued interactive requests start before background ones.
 class APIRequestHelper {
  public:
+  enum class Priority {
+    // The user is waiting on the response, e.g. they just asked for a swap
+    // quote. Sent at MEDIUM network priority.
+    kInteractive,
+    // Everything else, sent at IDLE network priority. This is the default.
+    kBackground,
+  };
+
+  // The network stack's limit of HTTP/1.1 connections per host. Requests
+  // above it wait in the network stack, where interactive requests can't
+  // overtake them. HTTP/2 and QUIC multiplex all requests to a host over one
+  // connection and have no such limit.
+  static constexpr size_t kHttp1MaxRequestsPerHost = 6;
+
   APIRequestHelper(
       net::NetworkTrafficAnnotationTag annotation_tag,
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
@@ -36,6 +59,10 @@ class APIRequestHelper {
       base::OnceCallback<void(const int,
                               const std::string&,
                               const base::flat_map<std::string, std::string>&)>;
+  using ValueResultCallback =
+      base::OnceCallback<void(const int,
+                              base::Value,
+                              const base::flat_map<std::string, std::string>&)>;
   using ResponseConversionCallback =
       base::OnceCallback<absl::optional<std::string>(
           const std::string& raw_response)>;
@@ -55,20 +82,91 @@ class APIRequestHelper {
       ResultCallback callback,
       const base::flat_map<std::string, std::string>& headers = {},
       size_t max_body_size = -1u,
-      ResponseConversionCallback conversion_callback = base::NullCallback());
+      ResponseConversionCallback conversion_callback = base::NullCallback(),
+      Priority priority = Priority::kBackground);
+
+  // Same as |Request|, but the response is parsed once by the data decoder
+  // instead of being sanitized back into a string, and the resulting value
+  // is handed over so that callers don't parse it again on their thread.
+  // The value is NONE when the response is missing or is not valid json.
+  void RequestJson(
+      const std::string& method,
+      const GURL& url,
+      const std::string& payload,
+      const std::string& payload_content_type,
+      bool auto_retry_on_network_change,
+      ValueResultCallback callback,
+      const base::flat_map<std::string, std::string>& headers = {},
+      size_t max_body_size = -1u,
+      ResponseConversionCallback conversion_callback = base::NullCallback(),
+      Priority priority = Priority::kBackground);
+
+  // Requests aren't capped by default. Helpers whose hosts only speak
+  // HTTP/1.1 can opt in with kHttp1MaxRequestsPerHost, so that their
+  // interactive requests don't queue behind background ones.
+  void set_max_requests_per_host(size_t max_requests_per_host) {
+    DCHECK_GT(max_requests_per_host, 0u);
+    max_requests_per_host_ = max_requests_per_host;
+  }
+
+  size_t queued_requests_count_for_testing() const {
+    return queued_jobs_.size();
+  }
+  size_t running_requests_count_for_testing() const {
+    return running_jobs_.size();
+  }
 
  private:
   APIRequestHelper(const APIRequestHelper&) = delete;
   APIRequestHelper& operator=(const APIRequestHelper&) = delete;
-  using SimpleURLLoaderList =
-      std::list<std::unique_ptr<network::SimpleURLLoader>>;
-  void OnResponse(SimpleURLLoaderList::iterator iter,
-                  ResultCallback callback,
-                  ResponseConversionCallback conversion_callback,
-                  const std::unique_ptr<std::string> response_body);
+  using DownloadCallback = base::OnceCallback<void(
+      const int,
+      std::unique_ptr<std::string>,
+      base::flat_map<std::string, std::string>)>;
+
+  // A download and everyone waiting on it.
+  struct Job {
+    Job();
+    ~Job();
+
+    std::unique_ptr<network::ResourceRequest> request;
+    std::string payload;
+    std::string payload_content_type;
+    bool auto_retry_on_network_change = false;
+    size_t max_body_size = -1u;
+    Priority priority = Priority::kBackground;
+    std::string host;
+    // Empty if the request can't be shared.
+    std::string coalescing_key;
+    std::vector<DownloadCallback> callbacks;
+    std::unique_ptr<network::SimpleURLLoader> url_loader;
+  };
+  using JobList = std::list<std::unique_ptr<Job>>;
+
+  void Download(const std::string& method,
+                const GURL& url,
+                const std::string& payload,
+                const std::string& payload_content_type,
+                bool auto_retry_on_network_change,
+                const base::flat_map<std::string, std::string>& headers,
+                size_t max_body_size,
+                Priority priority,
+                DownloadCallback callback);
+  // Starts queued jobs while there is room for them.
+  void MaybeStartJobs();
+  JobList::iterator PickNextJob();
+  void StartJob(JobList::iterator iter);
+  void OnDownload(JobList::iterator iter,
+                  std::unique_ptr<std::string> response_body);
 
   net::NetworkTrafficAnnotationTag annotation_tag_;
-  SimpleURLLoaderList url_loaders_;
+  // 0 if requests aren't capped.
+  size_t max_requests_per_host_ = 0;
+  // In the order they were requested.
+  JobList queued_jobs_;
+  JobList running_jobs_;
+  base::flat_map<std::string, size_t> running_jobs_per_host_;
+  base::flat_map<std::string, Job*> coalescable_jobs_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   base::WeakPtrFactory<APIRequestHelper> weak_ptr_factory_{this};
 };
@@ -5,11 +5,22 @@
 
 #include "brave/components/api_request_helper/api_request_helper.h"
 
+#include <algorithm>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/callback.h"
+#include "base/callback_helpers.h"
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
 #include "base/test/bind.h"
 #include "base/test/task_environment.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/test/busy_time_observer.h"
+#include "net/base/request_priority.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 #include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "services/data_decoder/public/cpp/test_support/in_process_data_decoder.h"
@@ -27,6 +38,36 @@ absl::optional<std::string> ConversionCallback(
   EXPECT_EQ(expected_raw_response, raw_response);
   return converted_response;
 }
+
+// Price history as returned by the asset ratio server.
+std::string GetPriceHistoryResponse(size_t point_count) {
+  std::string prices;
+  for (size_t i = 0; i < point_count; ++i) {
+    if (i)
+      prices += ",";
+    prices += base::StringPrintf("[%d,%d.8201346624954003]",
+                                 static_cast<int>(1622733088 + i * 60),
+                                 static_cast<int>(i % 100));
+  }
+  return "{\"payload\":{\"prices\":[" + prices + "]}}";
+}
+
+// Token list in the format of the wallet token registry.
+std::string GetTokenListResponse(size_t token_count) {
+  std::string tokens;
+  for (size_t i = 0; i < token_count; ++i) {
+    if (i)
+      tokens += ",";
+    tokens += base::StringPrintf(
+        "\"0x%040d\":{\"name\":\"Token %d\",\"logo\":\"token%d.svg\","
+        "\"erc20\":true,\"symbol\":\"TK%d\",\"decimals\":18,"
+        "\"chainId\":\"0x1\"}",
+        static_cast<int>(i), static_cast<int>(i), static_cast<int>(i),
+        static_cast<int>(i));
+  }
+  return "{" + tokens + "}";
+}
+
 }  // namespace
 
 class ApiRequestHelperUnitTest : public testing::Test {
@@ -85,12 +126,148 @@ class ApiRequestHelperUnitTest : public testing::Test {
     EXPECT_TRUE(callback_called);
   }
 
+  base::Value SendJsonRequest(const std::string& server_raw_response,
+                              const int expected_http_code = 200,
+                              APIRequestHelper::ResponseConversionCallback
+                                  conversion_callback = base::NullCallback()) {
+    base::Value result;
+    GURL network_url("http://localhost/");
+    SetInterceptor("POST", network_url, server_raw_response);
+    base::RunLoop run_loop;
+    api_request_helper_->RequestJson(
+        "POST", network_url, "", "application/json", false,
+        base::BindLambdaForTesting(
+            [&](const int http_code, base::Value value,
+                const base::flat_map<std::string, std::string>& headers) {
+              EXPECT_EQ(expected_http_code, http_code);
+              result = std::move(value);
+              run_loop.Quit();
+            }),
+        {}, -1u, std::move(conversion_callback));
+    run_loop.Run();
+    return result;
+  }
+
+  // Requests |response| through the sanitizer and parses the sanitized
+  // string in the callback as callers used to, then through |RequestJson|.
+  void CompareParsing(const std::string& name, const std::string& response) {
+    GURL network_url("http://localhost/");
+    SetInterceptor("GET", network_url, response);
+    BusyTimeObserver observer;
+
+    base::ElapsedTimer sanitized_timer;
+    base::RunLoop sanitized_run_loop;
+    api_request_helper_->Request(
+        "GET", network_url, "", "", false,
+        base::BindLambdaForTesting(
+            [&](const int http_code, const std::string& body,
+                const base::flat_map<std::string, std::string>& headers) {
+              EXPECT_TRUE(base::JSONReader::Read(body));
+              sanitized_run_loop.Quit();
+            }));
+    sanitized_run_loop.Run();
+    const base::TimeDelta sanitized_time = sanitized_timer.Elapsed();
+    const base::TimeDelta sanitized_busy_time = observer.TakeBusyTime();
+
+    base::ElapsedTimer parsed_timer;
+    base::RunLoop parsed_run_loop;
+    api_request_helper_->RequestJson(
+        "GET", network_url, "", "", false,
+        base::BindLambdaForTesting(
+            [&](const int http_code, base::Value value,
+                const base::flat_map<std::string, std::string>& headers) {
+              EXPECT_TRUE(value.is_dict());
+              parsed_run_loop.Quit();
+            }));
+    parsed_run_loop.Run();
+    const base::TimeDelta parsed_time = parsed_timer.Elapsed();
+    const base::TimeDelta parsed_busy_time = observer.TakeBusyTime();
+
+    VLOG(1) << name << " of " << response.size()
+            << " bytes, sanitize and parse: " << sanitized_time << " ("
+            << sanitized_busy_time << " on the calling thread), "
+            << "parse once: " << parsed_time << " (" << parsed_busy_time
+            << " on the calling thread)";
+  }
+
+  // Sends a GET which stays pending in the url loader factory until it is
+  // answered by |RespondTo|.
+  void StartRequest(const GURL& url,
+                    APIRequestHelper::Priority priority,
+                    base::OnceCallback<void(const std::string&)> callback) {
+    api_request_helper_->Request(
+        "GET", url, "", "", false,
+        base::BindOnce(
+            [](base::OnceCallback<void(const std::string&)> callback,
+               const int http_code, const std::string& body,
+               const base::flat_map<std::string, std::string>& headers) {
+              std::move(callback).Run(body);
+            },
+            std::move(callback)),
+        {}, -1u, base::NullCallback(), priority);
+  }
+
+  void RespondTo(const GURL& url, const std::string& content = "{}") {
+    EXPECT_TRUE(
+        url_loader_factory_.SimulateResponseForPendingRequest(url.spec(),
+                                                              content));
+    base::RunLoop().RunUntilIdle();
+  }
+
+  std::vector<GURL> GetPendingURLs() {
+    std::vector<GURL> urls;
+    for (const auto& pending_request : *url_loader_factory_.pending_requests())
+      urls.push_back(pending_request.request.url);
+    return urls;
+  }
+
+  // Sends |background_count| background requests to the same host, 6 every
+  // 6 ticks, and an interactive request every 8 ticks. The server answers
+  // the oldest request each tick. Returns how many ticks each interactive
+  // request waited for its response.
+  std::vector<size_t> RunUnderBackgroundLoad(
+      size_t background_count,
+      APIRequestHelper::Priority interactive_priority) {
+    std::vector<size_t> waits;
+    size_t tick = 0;
+    size_t background_sent = 0;
+    size_t interactive_sent = 0;
+    while (background_sent < background_count ||
+           !url_loader_factory_.pending_requests()->empty()) {
+      if (tick % 6 == 0) {
+        for (int i = 0; i < 6 && background_sent < background_count; ++i) {
+          StartRequest(
+              GURL(base::StringPrintf("https://api.example.com/background/%d",
+                                      static_cast<int>(background_sent++))),
+              APIRequestHelper::Priority::kBackground, base::DoNothing());
+        }
+      }
+      if (tick % 8 == 0 && background_sent < background_count) {
+        const size_t sent_at = tick;
+        StartRequest(
+            GURL(base::StringPrintf("https://api.example.com/interactive/%d",
+                                    static_cast<int>(interactive_sent++))),
+            interactive_priority,
+            base::BindLambdaForTesting([&, sent_at](const std::string&) {
+              waits.push_back(tick - sent_at);
+            }));
+      }
+      ++tick;
+      if (url_loader_factory_.pending_requests()->empty())
+        continue;
+      const GURL oldest =
+          url_loader_factory_.pending_requests()->front().request.url;
+      RespondTo(oldest);
+    }
+    return waits;
+  }
+
  protected:
   std::unique_ptr<APIRequestHelper> api_request_helper_;
-
- private:
   base::test::TaskEnvironment task_environment_;
   network::TestURLLoaderFactory url_loader_factory_;
+
+ private:
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
   data_decoder::test::InProcessDataDecoder in_process_data_decoder_;
 };
@@ -143,4 +320,199 @@ TEST_F(ApiRequestHelperUnitTest, RequestWithConversion) {
       base::BindOnce(&ConversionCallback, server_raw_response, absl::nullopt));
 }
 
+TEST_F(ApiRequestHelperUnitTest, JsonRequest) {
+  base::Value value = SendJsonRequest(
+      "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":\"0x1\"}");
+  ASSERT_TRUE(value.is_dict());
+  EXPECT_EQ(*value.FindStringKey("result"), "0x1");
+  EXPECT_TRUE(SendJsonRequest("").is_none());
+  EXPECT_TRUE(SendJsonRequest("{").is_none());
+  EXPECT_TRUE(SendJsonRequest("a").is_none());
+  EXPECT_TRUE(SendJsonRequest("[]").is_list());
+}
+
+TEST_F(ApiRequestHelperUnitTest, JsonRequestWithConversion) {
+  const std::string server_raw_response =
+      "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":18446744073709551615}";
+  const std::string converted_response =
+      "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":\"18446744073709551615\"}";
+  base::Value value = SendJsonRequest(
+      server_raw_response, 200,
+      base::BindOnce(&ConversionCallback, server_raw_response,
+                     converted_response));
+  ASSERT_TRUE(value.is_dict());
+  EXPECT_EQ(*value.FindStringKey("result"), "18446744073709551615");
+
+  // Returning absl::nullopt in conversion callback fails the request.
+  EXPECT_TRUE(SendJsonRequest(server_raw_response, 422,
+                              base::BindOnce(&ConversionCallback,
+                                             server_raw_response,
+                                             absl::nullopt))
+                  .is_none());
+}
+
+TEST_F(ApiRequestHelperUnitTest, LargeResponses) {
+  CompareParsing("Price history", GetPriceHistoryResponse(20000));
+  CompareParsing("Token list", GetTokenListResponse(5000));
+}
+
+TEST_F(ApiRequestHelperUnitTest, MaxRequestsPerHost) {
+  api_request_helper_->set_max_requests_per_host(2);
+  size_t responses = 0;
+  for (int i = 0; i < 5; ++i) {
+    StartRequest(GURL(base::StringPrintf("https://a.com/%d", i)),
+                 APIRequestHelper::Priority::kInteractive,
+                 base::BindLambdaForTesting(
+                     [&](const std::string& body) { ++responses; }));
+  }
+  EXPECT_EQ(GetPendingURLs(), std::vector<GURL>({GURL("https://a.com/0"),
+                                                  GURL("https://a.com/1")}));
+  EXPECT_EQ(api_request_helper_->queued_requests_count_for_testing(), 3u);
+
+  RespondTo(GURL("https://a.com/1"));
+  EXPECT_EQ(responses, 1u);
+  EXPECT_EQ(GetPendingURLs(), std::vector<GURL>({GURL("https://a.com/0"),
+                                                  GURL("https://a.com/2")}));
+  RespondTo(GURL("https://a.com/0"));
+  RespondTo(GURL("https://a.com/2"));
+  RespondTo(GURL("https://a.com/3"));
+  RespondTo(GURL("https://a.com/4"));
+  EXPECT_EQ(responses, 5u);
+  EXPECT_EQ(api_request_helper_->queued_requests_count_for_testing(), 0u);
+  EXPECT_EQ(api_request_helper_->running_requests_count_for_testing(), 0u);
+}
+
+TEST_F(ApiRequestHelperUnitTest, InteractiveBeforeBackground) {
+  api_request_helper_->set_max_requests_per_host(1);
+  const GURL background1("https://a.com/background1");
+  const GURL background2("https://a.com/background2");
+  const GURL interactive("https://a.com/interactive");
+  StartRequest(background1, APIRequestHelper::Priority::kBackground,
+               base::DoNothing());
+  StartRequest(background2, APIRequestHelper::Priority::kBackground,
+               base::DoNothing());
+  StartRequest(interactive, APIRequestHelper::Priority::kInteractive,
+               base::DoNothing());
+  ASSERT_EQ(GetPendingURLs(), std::vector<GURL>({background1}));
+  EXPECT_EQ(url_loader_factory_.pending_requests()->front().request.priority,
+            net::IDLE);
+
+  RespondTo(background1);
+  ASSERT_EQ(GetPendingURLs(), std::vector<GURL>({interactive}));
+  EXPECT_EQ(url_loader_factory_.pending_requests()->front().request.priority,
+            net::MEDIUM);
+  RespondTo(interactive);
+  EXPECT_EQ(GetPendingURLs(), std::vector<GURL>({background2}));
+}
+
+TEST_F(ApiRequestHelperUnitTest, HostsDontWaitForEachOther) {
+  api_request_helper_->set_max_requests_per_host(2);
+  for (int i = 0; i < 4; ++i) {
+    StartRequest(GURL(base::StringPrintf("https://a.com/%d", i)),
+                 APIRequestHelper::Priority::kBackground, base::DoNothing());
+  }
+  StartRequest(GURL("https://b.com/0"),
+               APIRequestHelper::Priority::kBackground, base::DoNothing());
+  EXPECT_EQ(GetPendingURLs(), std::vector<GURL>({GURL("https://a.com/0"),
+                                                  GURL("https://a.com/1"),
+                                                  GURL("https://b.com/0")}));
+
+  RespondTo(GURL("https://b.com/0"));
+  EXPECT_EQ(api_request_helper_->queued_requests_count_for_testing(), 2u);
+  RespondTo(GURL("https://a.com/0"));
+  EXPECT_EQ(GetPendingURLs(), std::vector<GURL>({GURL("https://a.com/1"),
+                                                  GURL("https://a.com/2")}));
+}
+
+TEST_F(ApiRequestHelperUnitTest, NoMaxRequestsPerHostByDefault) {
+  for (int i = 0; i < 10; ++i) {
+    StartRequest(GURL(base::StringPrintf("https://a.com/%d", i)),
+                 APIRequestHelper::Priority::kBackground, base::DoNothing());
+  }
+  EXPECT_EQ(GetPendingURLs().size(), 10u);
+  EXPECT_EQ(api_request_helper_->queued_requests_count_for_testing(), 0u);
+}
+
+TEST_F(ApiRequestHelperUnitTest, DefaultsToBackground) {
+  api_request_helper_->Request("GET", GURL("https://a.com/"), "", "", false,
+                               base::DoNothing());
+  ASSERT_EQ(url_loader_factory_.pending_requests()->size(), 1u);
+  EXPECT_EQ(url_loader_factory_.pending_requests()->front().request.priority,
+            net::IDLE);
+}
+
+TEST_F(ApiRequestHelperUnitTest, CoalescesIdenticalRequests) {
+  api_request_helper_->set_max_requests_per_host(1);
+  const GURL url("https://a.com/feed.json");
+  std::vector<std::string> bodies;
+  auto record_body = base::BindLambdaForTesting(
+      [&](const std::string& body) { bodies.push_back(body); });
+  StartRequest(GURL("https://a.com/other"),
+               APIRequestHelper::Priority::kInteractive, record_body);
+  StartRequest(url, APIRequestHelper::Priority::kBackground, record_body);
+  // Joins the queued request and raises its priority.
+  StartRequest(url, APIRequestHelper::Priority::kInteractive, record_body);
+  EXPECT_EQ(api_request_helper_->queued_requests_count_for_testing(), 1u);
+
+  RespondTo(GURL("https://a.com/other"));
+  ASSERT_EQ(GetPendingURLs(), std::vector<GURL>({url}));
+  EXPECT_EQ(url_loader_factory_.pending_requests()->front().request.priority,
+            net::MEDIUM);
+  // Joins the running request.
+  StartRequest(url, APIRequestHelper::Priority::kInteractive, record_body);
+  EXPECT_EQ(api_request_helper_->queued_requests_count_for_testing(), 0u);
+
+  RespondTo(url, "{\"a\":1}");
+  EXPECT_EQ(bodies.size(), 4u);
+  EXPECT_EQ(std::count(bodies.begin(), bodies.end(), "{\"a\":1}"), 3);
+  EXPECT_TRUE(GetPendingURLs().empty());
+
+  // Requests with side effects are always sent.
+  for (int i = 0; i < 2; ++i) {
+    api_request_helper_->Request("POST", url, "{}", "application/json", false,
+                                 base::DoNothing());
+  }
+  EXPECT_EQ(GetPendingURLs().size() +
+                api_request_helper_->queued_requests_count_for_testing(),
+            2u);
+}
+
+TEST_F(ApiRequestHelperUnitTest, RetryOptionIsPartOfCoalescingKey) {
+  const GURL url("https://a.com/feed.json");
+  api_request_helper_->Request("GET", url, "", "", true, base::DoNothing());
+  api_request_helper_->Request("GET", url, "", "", false, base::DoNothing());
+  EXPECT_EQ(GetPendingURLs(), std::vector<GURL>({url, url}));
+}
+
+// Compares how long interactive requests wait behind a steady stream of
+// background refreshes when they are sent as background requests, which is
+// first come first served, and when they are sent as interactive requests.
+TEST_F(ApiRequestHelperUnitTest, TailLatencyUnderBackgroundLoad) {
+  constexpr size_t kBackgroundCount = 300;
+  api_request_helper_->set_max_requests_per_host(
+      APIRequestHelper::kHttp1MaxRequestsPerHost);
+  auto unprioritized = RunUnderBackgroundLoad(
+      kBackgroundCount, APIRequestHelper::Priority::kBackground);
+  auto prioritized = RunUnderBackgroundLoad(
+      kBackgroundCount, APIRequestHelper::Priority::kInteractive);
+  ASSERT_FALSE(unprioritized.empty());
+  ASSERT_EQ(unprioritized.size(), prioritized.size());
+
+  std::sort(unprioritized.begin(), unprioritized.end());
+  std::sort(prioritized.begin(), prioritized.end());
+  const size_t p95 = prioritized.size() * 95 / 100;
+  VLOG(1) << prioritized.size() << " interactive requests under "
+          << kBackgroundCount << " background requests waited for "
+          << "p50/p95/max responses, unprioritized: "
+          << unprioritized[unprioritized.size() / 2] << "/"
+          << unprioritized[p95] << "/" << unprioritized.back()
+          << ", prioritized: " << prioritized[prioritized.size() / 2] << "/"
+          << prioritized[p95] << "/" << prioritized.back();
+
+  EXPECT_LT(prioritized[p95], unprioritized[p95]);
+  // Only the requests already sent are ahead of an interactive request.
+  EXPECT_LE(prioritized.back(),
+            APIRequestHelper::kHttp1MaxRequestsPerHost + 1);
+}
+
 }  // namespace api_request_helper
@@ -100,6 +100,12 @@ class AdsService : public KeyedService {
 
   virtual void ChangeLocale(const std::string& locale) = 0;
 
+  // Returns true if a conversion may find its conversion id in the HTML of
+  // the page at the end of |redirect_chain|. Otherwise the page's HTML isn't
+  // needed and |OnHtmlLoaded| should be called with an empty |html|.
+  virtual bool ShouldExtractConversionId(
+      const std::vector<GURL>& redirect_chain) const = 0;
+
   virtual void OnHtmlLoaded(const SessionID& tab_id,
                             const std::vector<GURL>& redirect_chain,
                             const std::string& html) = 0;
@@ -24,7 +24,7 @@ namespace brave_rewards {
 namespace {
 
 void DispatchOnUI(
-    const std::string post_data,
+    const std::string& post_data,
     const GURL url,
     const GURL first_party_url,
     const std::string referrer,
@@ -55,8 +55,9 @@ int OnBeforeURLRequest(
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
   if (IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer)) {
-    if (!ctx->upload_data.empty()) {
-      DispatchOnUI(ctx->upload_data, ctx->request_url, ctx->tab_url,
+    const std::string upload_data = ctx->GetUploadData();
+    if (!upload_data.empty()) {
+      DispatchOnUI(upload_data, ctx->request_url, ctx->tab_url,
                    ctx->referrer.spec(), ctx->frame_tree_node_id);
     }
   }
@@ -33,6 +33,10 @@ bool IsMediaLink(const GURL& url,
                  const GURL& first_party_url,
                  const GURL& referrer);
 
+bool IsMediaEventLink(const GURL& url,
+                      const GURL& first_party_url,
+                      const GURL& referrer);
+
 class RewardsNotificationService;
 class RewardsServiceObserver;
 class RewardsServicePrivateObserver;
@@ -290,6 +290,13 @@ bool IsMediaLink(const GURL& url,
                                      referrer.spec());
 }
 
+bool IsMediaEventLink(const GURL& url,
+                      const GURL& first_party_url,
+                      const GURL& referrer) {
+  return ledger::Ledger::IsMediaEventLink(url.spec(), first_party_url.spec(),
+                                          referrer.spec());
+}
+
 
 // read comment about file pathes at src\base\files\file_path.h
 #if BUILDFLAG(IS_WIN)
@@ -743,6 +750,11 @@ void RewardsServiceImpl::OnPostData(SessionID tab_id,
     return;
   }
 
+  // Most requests aren't media events, don't send them to the ledger process.
+  if (!IsMediaEventLink(url, first_party_url, referrer)) {
+    return;
+  }
+
   std::string output;
   url::RawCanonOutputW<1024> canonOutput;
   url::DecodeURLEscapeSequences(post_data.c_str(),
@@ -778,6 +790,11 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
     return;
   }
 
+  // Most requests aren't media events, don't send them to the ledger process.
+  if (!IsMediaEventLink(url, first_party_url, referrer)) {
+    return;
+  }
+
   base::flat_map<std::string, std::string> parts;
 
   for (net::QueryIterator it(url); !it.IsAtEnd(); it.Advance()) {
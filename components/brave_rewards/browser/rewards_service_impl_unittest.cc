@@ -4,9 +4,14 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "base/files/scoped_temp_dir.h"
+#include "base/logging.h"
 #include "base/memory/raw_ptr.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/test/scoped_feature_list.h"
 #include "bat/ledger/global_constants.h"
 #include "bat/ledger/mojom_structs.h"
@@ -25,6 +30,7 @@
 #include "content/public/test/browser_task_environment.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
 
 // npm run test -- brave_unit_tests --filter=RewardsServiceTest.*
 
@@ -157,4 +163,77 @@ TEST_F(RewardsServiceTest, GetExternalWalletMultipleCustodians) {
 }
 #endif
 
+TEST_F(RewardsServiceTest, IsMediaEventLink) {
+  const GURL twitch("https://www.twitch.tv/");
+  EXPECT_TRUE(IsMediaEventLink(
+      GURL("https://video-edge-1.abc.hls.ttvnw.net/v1/segment/a.ts"), twitch,
+      GURL()));
+  EXPECT_FALSE(IsMediaEventLink(
+      GURL("https://video-edge-1.abc.hls.ttvnw.net/v1/segment/a.ts"),
+      GURL("https://brave.com/"), GURL()));
+  EXPECT_FALSE(
+      IsMediaEventLink(GURL("https://gql.twitch.tv/gql"), twitch, GURL()));
+  EXPECT_TRUE(IsMediaEventLink(
+      GURL("https://fresnel.vimeocdn.com/add/player-stats?id=1"),
+      GURL("https://vimeo.com/1"), GURL()));
+  EXPECT_FALSE(IsMediaEventLink(GURL("https://brave.com/script.js"),
+                                GURL("https://brave.com/"), GURL()));
+}
+
+// Replays ten minutes of request loads: five minutes on a news site, three
+// watching a Twitch stream and two watching a Vimeo video, and counts the
+// ones that are sent to the ledger process.
+TEST_F(RewardsServiceTest, MediaEventLinksReplay) {
+  const GURL news("https://news.example.com/");
+  const GURL twitch("https://www.twitch.tv/");
+  const GURL vimeo("https://vimeo.com/1");
+
+  std::vector<std::pair<GURL, GURL>> requests;
+  size_t media_event_count = 0;
+  for (int second = 0; second < 10 * 60; ++second) {
+    const std::string id = base::NumberToString(second);
+    if (second < 5 * 60) {
+      requests.emplace_back(GURL("https://cdn.example.com/img/" + id), news);
+      requests.emplace_back(GURL("https://ads.example.net/bid?id=" + id), news);
+      requests.emplace_back(GURL("https://analytics.example.org/c?" + id),
+                            news);
+      requests.emplace_back(GURL("https://news.example.com/api/" + id), news);
+      requests.emplace_back(GURL("https://fonts.example.com/f.woff"), news);
+    } else if (second < 8 * 60) {
+      requests.emplace_back(GURL("https://gql.twitch.tv/gql"), twitch);
+      requests.emplace_back(GURL("https://static.twitchcdn.net/" + id), twitch);
+      requests.emplace_back(GURL("https://spade.twitch.tv/track"), twitch);
+      if (second % 2 == 0) {
+        requests.emplace_back(
+            GURL("https://video-edge-1.abc.hls.ttvnw.net/v1/segment/" + id),
+            twitch);
+        ++media_event_count;
+      }
+    } else {
+      for (int i = 0; i < 4; ++i) {
+        requests.emplace_back(
+            GURL("https://vod.vimeocdn.com/" + id + "/" +
+                 base::NumberToString(i)),
+            vimeo);
+      }
+      if (second % 10 == 0) {
+        requests.emplace_back(
+            GURL("https://fresnel.vimeocdn.com/add/player-stats?id=" + id),
+            vimeo);
+        ++media_event_count;
+      }
+    }
+  }
+
+  size_t sent_count = 0;
+  for (const auto& [url, first_party_url] : requests) {
+    if (IsMediaEventLink(url, first_party_url, GURL()))
+      ++sent_count;
+  }
+
+  VLOG(1) << requests.size() << " request loads, " << sent_count
+          << " sent to the ledger process";
+  EXPECT_EQ(sent_count, media_event_count);
+}
+
 }  // namespace brave_rewards
@@ -15,7 +15,9 @@
 #include "base/barrier_callback.h"
 #include "base/callback.h"
 #include "base/containers/flat_set.h"
+#include "base/hash/hash.h"
 #include "base/logging.h"
+#include "base/task/thread_pool.h"
 #include "base/time/time.h"
 #include "brave/components/brave_private_cdn/headers.h"
 #include "brave/components/brave_today/browser/network.h"
@@ -64,6 +66,23 @@ mojom::ArticlePtr RustFeedItemToArticle(const FeedItem& rust_feed_item) {
   return article;
 }
 
+// Runs on a background sequence, each feed is parsed in its own task so
+// that feeds are parsed in parallel.
+std::unique_ptr<DirectFeedResponse> ParseFeed(
+    const std::string& body_content,
+    std::unique_ptr<DirectFeedResponse> result) {
+  FeedData data;
+  if (!parse_feed_string(::rust::String(body_content), data)) {
+    VLOG(1) << result->url.spec() << " not a valid feed.";
+    VLOG(2) << "Response body was:";
+    VLOG(2) << body_content;
+    return result;
+  }
+  result->success = true;
+  result->data = std::move(data);
+  return result;
+}
+
 }  // namespace
 
 DirectFeedController::DirectFeedController(
@@ -126,9 +145,14 @@ void DirectFeedController::DownloadAllContent(
   for (auto& publisher : publishers) {
     VLOG(1) << "Downloading feed content from "
             << publisher->feed_source.spec();
+    direct_feed_urls.insert(publisher->feed_source);
     DownloadFeedContent(publisher->feed_source, publisher->publisher_id,
                         feed_content_handler);
   }
+  // Forget feeds which were removed.
+  base::EraseIf(parsed_feeds_, [&direct_feed_urls](const auto& entry) {
+    return !direct_feed_urls.contains(entry.first);
+  });
 }
 
 void DirectFeedController::DownloadFeedContent(const GURL& feed_url,
@@ -226,18 +250,35 @@ void DirectFeedController::OnResponse(
     std::move(callback).Run(std::move(result));
     return;
   }
-  // Reponse is valid, but still might not be a feed
-  FeedData data;
-  if (!parse_feed_string(::rust::String(body_content), data)) {
-    VLOG(1) << feed_url.spec() << " not a valid feed.";
-    VLOG(2) << "Response body was:";
-    VLOG(2) << body_content;
+  // Reponse is valid, but still might not be a feed. Only parse it if it
+  // changed since the last time.
+  const uint32_t body_hash = base::FastHash(body_content);
+  auto parsed_feed = parsed_feeds_.find(feed_url);
+  if (parsed_feed != parsed_feeds_.end() &&
+      parsed_feed->second.body_hash == body_hash) {
+    VLOG(1) << feed_url.spec() << " did not change.";
+    result->success = true;
+    result->data = parsed_feed->second.data;
     std::move(callback).Run(std::move(result));
     return;
   }
-  // Valid feed
-  result->success = true;
-  result->data = data;
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ParseFeed, std::move(body_content), std::move(result)),
+      base::BindOnce(&DirectFeedController::OnParsedFeed,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback),
+                     body_hash));
+}
+
+void DirectFeedController::OnParsedFeed(
+    DownloadFeedCallback callback,
+    uint32_t body_hash,
+    std::unique_ptr<DirectFeedResponse> result) {
+  if (result->success) {
+    ParsedFeed& parsed_feed = parsed_feeds_[result->url];
+    parsed_feed.body_hash = body_hash;
+    parsed_feed.data = result->data;
+  }
   std::move(callback).Run(std::move(result));
 }
 
@@ -12,7 +12,10 @@
 #include <vector>
 
 #include "base/callback_forward.h"
+#include "base/containers/flat_map.h"
+#include "base/gtest_prod_util.h"
 #include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
 #include "brave/components/brave_today/common/brave_news.mojom-forward.h"
 #include "brave/components/brave_today/rust/lib.rs.h"
 #include "url/gurl.h"
@@ -59,6 +62,8 @@ class DirectFeedController {
                           GetFeedItemsCallback callback);
 
  private:
+  FRIEND_TEST_ALL_PREFIXES(BraveNewsDirectFeed, DownloadAllContent);
+
   using SimpleURLLoaderList =
       std::list<std::unique_ptr<network::SimpleURLLoader>>;
   void DownloadFeedContent(const GURL& feed_url,
@@ -69,9 +74,21 @@ class DirectFeedController {
                   DownloadFeedCallback callback,
                   const GURL& feed_url,
                   const std::unique_ptr<std::string> response_body);
+  void OnParsedFeed(DownloadFeedCallback callback,
+                    uint32_t body_hash,
+                    std::unique_ptr<DirectFeedResponse> result);
+
+  struct ParsedFeed {
+    uint32_t body_hash = 0;
+    FeedData data;
+  };
 
   SimpleURLLoaderList url_loaders_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
+  // Last successful parse of each feed, so that a feed is only parsed again
+  // when its content changes.
+  base::flat_map<GURL, ParsedFeed> parsed_feeds_;
+  base::WeakPtrFactory<DirectFeedController> weak_ptr_factory_{this};
 };
 
 }  // namespace brave_news
@@ -12,7 +12,15 @@
 
 #include "base/containers/flat_map.h"
 #include "base/logging.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "brave/components/brave_today/browser/direct_feed_controller.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
 #include "brave/components/brave_today/rust/lib.rs.h"
+#include "content/public/test/browser_task_environment.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_news {
@@ -140,4 +148,57 @@ TEST(BraveNewsDirectFeed, ParseFeed) {
             "c5f85f34aa685221604f7e434415ca82");
 }
 
+// Refreshes 100 direct feeds, and checks that only the feeds that changed
+// since the last refresh are parsed again.
+TEST(BraveNewsDirectFeed, DownloadAllContent) {
+  constexpr size_t kPublisherCount = 100;
+  content::BrowserTaskEnvironment task_environment;
+  network::TestURLLoaderFactory url_loader_factory;
+  DirectFeedController controller(
+      base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+          &url_loader_factory));
+
+  std::vector<mojom::PublisherPtr> publishers;
+  for (size_t i = 0; i < kPublisherCount; ++i) {
+    auto publisher = mojom::Publisher::New();
+    publisher->publisher_id = base::StringPrintf("%d", static_cast<int>(i));
+    publisher->type = mojom::PublisherType::DIRECT_SOURCE;
+    publisher->feed_source = GURL(base::StringPrintf(
+        "https://feed%d.example.com/rss", static_cast<int>(i)));
+    url_loader_factory.AddResponse(publisher->feed_source.spec(),
+                                   GetFeedJson());
+    publishers.push_back(std::move(publisher));
+  }
+
+  auto refresh = [&]() {
+    std::vector<mojom::PublisherPtr> clone;
+    for (const auto& publisher : publishers)
+      clone.push_back(publisher->Clone());
+    size_t item_count = 0;
+    base::RunLoop run_loop;
+    controller.DownloadAllContent(
+        std::move(clone), base::BindLambdaForTesting(
+                              [&](std::vector<mojom::FeedItemPtr> items) {
+                                item_count = items.size();
+                                run_loop.Quit();
+                              }));
+    run_loop.Run();
+    return item_count;
+  };
+
+  EXPECT_EQ(refresh(), 3 * kPublisherCount);
+  EXPECT_EQ(controller.parsed_feeds_.size(), kPublisherCount);
+
+  // Unchanged feeds are served from their last parse, so emptying one of
+  // them shows up in the next refresh.
+  const GURL& feed_url = publishers[0]->feed_source;
+  controller.parsed_feeds_[feed_url].data.items = ::rust::Vec<FeedItem>();
+  EXPECT_EQ(refresh(), 3 * (kPublisherCount - 1));
+
+  // A feed whose content changed is parsed again.
+  url_loader_factory.AddResponse(feed_url.spec(), GetFeedJson() + "\n");
+  EXPECT_EQ(refresh(), 3 * kPublisherCount);
+  EXPECT_EQ(controller.parsed_feeds_[feed_url].data.items.size(), 3u);
+}
+
 }  // namespace brave_news
@@ -15,6 +15,7 @@
 #include "base/bind.h"
 #include "base/callback_forward.h"
 #include "base/one_shot_event.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_private_cdn/headers.h"
 #include "brave/components/brave_today/browser/direct_feed_controller.h"
@@ -39,6 +40,34 @@ GURL GetFeedUrl() {
   return feed_url;
 }
 
+FeedItems CloneFeedItems(const FeedItems& feed_items) {
+  FeedItems clone;
+  clone.reserve(feed_items.size());
+  for (const auto& item : feed_items)
+    clone.push_back(item->Clone());
+  return clone;
+}
+
+// Parsing and building run on a background sequence since they go through
+// every article of every publisher. Relative times are formatted once the
+// items are back on the UI thread, see SetRelativeTimeDescriptions.
+FeedItems ParseFeedItemsInBackground(const std::string& body) {
+  FeedItems feed_items;
+  ParseFeedItems(body, &feed_items);
+  return feed_items;
+}
+
+mojom::FeedPtr BuildFeedInBackground(
+    const FeedItems& feed_items,
+    const std::unordered_set<std::string>& history_hosts,
+    Publishers publishers) {
+  auto feed = mojom::Feed::New();
+  if (!BuildFeed(feed_items, history_hosts, &publishers, feed.get())) {
+    VLOG(1) << "ParseFeed reported failure.";
+  }
+  return feed;
+}
+
 }  // namespace
 
 FeedController::FeedController(
@@ -148,16 +177,17 @@ void FeedController::EnsureFeedIsUpdating() {
                       history_hosts.insert(host);
                     }
                     VLOG(1) << "history hosts # " << history_hosts.size();
-                    // Parse directly to in-memory property
-                    controller->ResetFeed();
-                    std::vector<mojom::FeedItemPtr> feed_items;
-                    if (BuildFeed(all_feed_items, history_hosts, &publishers,
-                                  &controller->current_feed_)) {
-                    } else {
-                      VLOG(1) << "ParseFeed reported failure.";
-                    }
-                    // Let any callbacks know that the data is ready or errored.
-                    controller->NotifyUpdateDone();
+                    // Build the feed in the background, the result goes to
+                    // the in-memory property.
+                    base::ThreadPool::PostTaskAndReplyWithResult(
+                        FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+                        base::BindOnce(&BuildFeedInBackground,
+                                       std::move(all_feed_items),
+                                       std::move(history_hosts),
+                                       std::move(publishers)),
+                        base::BindOnce(&FeedController::OnBuiltFeed,
+                                       controller->weak_ptr_factory_
+                                           .GetWeakPtr()));
                   },
                   base::Unretained(controller), std::move(all_feed_items),
                   std::move(publishers));
@@ -233,6 +263,8 @@ void FeedController::UpdateIfRemoteChanged() {
 
 void FeedController::ClearCache() {
   ResetFeed();
+  parsed_feed_items_.clear();
+  parsed_feed_items_etag_.clear();
 }
 
 void FeedController::OnPublishersUpdated(PublishersController* controller) {
@@ -261,9 +293,21 @@ void FeedController::FetchCombinedFeed(GetFeedItemsCallback callback) {
         // Only mark cache time of remote request if
         // parsing was successful
         controller->current_feed_etag_ = etag;
-        FeedItems feed_items;
-        ParseFeedItems(body, &feed_items);
-        std::move(callback).Run(std::move(feed_items));
+        // Nothing to parse if the feed didn't change since the last parse.
+        if (!etag.empty() && etag == controller->parsed_feed_items_etag_) {
+          VLOG(1) << "Feed did not change, reusing parsed items";
+          FeedItems feed_items = CloneFeedItems(controller->parsed_feed_items_);
+          // Time has passed since the items were parsed.
+          SetRelativeTimeDescriptions(&feed_items);
+          std::move(callback).Run(std::move(feed_items));
+          return;
+        }
+        base::ThreadPool::PostTaskAndReplyWithResult(
+            FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+            base::BindOnce(&ParseFeedItemsInBackground, body),
+            base::BindOnce(&FeedController::OnParsedCombinedFeed,
+                           controller->weak_ptr_factory_.GetWeakPtr(),
+                           std::move(callback), etag));
       },
       base::Unretained(this), std::move(callback));
   // Send the request
@@ -274,6 +318,24 @@ void FeedController::FetchCombinedFeed(GetFeedItemsCallback callback) {
                                brave::private_cdn_headers);
 }
 
+void FeedController::OnParsedCombinedFeed(GetFeedItemsCallback callback,
+                                          const std::string& etag,
+                                          FeedItems feed_items) {
+  parsed_feed_items_ = CloneFeedItems(feed_items);
+  parsed_feed_items_etag_ = etag;
+  SetRelativeTimeDescriptions(&feed_items);
+  std::move(callback).Run(std::move(feed_items));
+}
+
+void FeedController::OnBuiltFeed(mojom::FeedPtr feed) {
+  ResetFeed();
+  current_feed_.hash = std::move(feed->hash);
+  current_feed_.pages = std::move(feed->pages);
+  current_feed_.featured_item = std::move(feed->featured_item);
+  // Let any callbacks know that the data is ready or errored.
+  NotifyUpdateDone();
+}
+
 void FeedController::GetOrFetchFeed(base::OnceClosure callback) {
   VLOG(1) << "getorfetch feed(oc) start: "
           << on_current_update_complete_->is_signaled();
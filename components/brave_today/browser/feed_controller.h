@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/one_shot_event.h"
 #include "base/scoped_observation.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
@@ -65,6 +66,10 @@ class FeedController : public PublishersController::Observer {
 
  private:
   void FetchCombinedFeed(GetFeedItemsCallback callback);
+  void OnParsedCombinedFeed(GetFeedItemsCallback callback,
+                            const std::string& etag,
+                            FeedItems feed_items);
+  void OnBuiltFeed(mojom::FeedPtr feed);
   void GetOrFetchFeed(base::OnceClosure callback);
   void ResetFeed();
   void NotifyUpdateDone();
@@ -85,7 +90,14 @@ class FeedController : public PublishersController::Observer {
   // every time the UI opens.
   mojom::Feed current_feed_;
   std::string current_feed_etag_;
+  // Items parsed from the combined feed for |parsed_feed_items_etag_|, so
+  // that the feed can be rebuilt without parsing it again, e.g. when the
+  // user changes which publishers are enabled. Relative times are left empty
+  // and formatted for each build.
+  FeedItems parsed_feed_items_;
+  std::string parsed_feed_items_etag_;
   bool is_update_in_progress_ = false;
+  base::WeakPtrFactory<FeedController> weak_ptr_factory_{this};
 };
 
 }  // namespace brave_news
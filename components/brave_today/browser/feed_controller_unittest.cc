@@ -0,0 +1,186 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/feed_controller.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/time/time.h"
+#include "brave/components/api_request_helper/api_request_helper.h"
+#include "brave/components/brave_today/browser/brave_news_controller.h"
+#include "brave/components/brave_today/browser/direct_feed_controller.h"
+#include "brave/components/brave_today/browser/publishers_controller.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
+#include "components/history/core/browser/history_service.h"
+#include "components/history/core/test/history_service_test_util.h"
+#include "components/prefs/testing_pref_service.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/http/http_status_code.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/data_decoder/public/cpp/test_support/in_process_data_decoder.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "services/network/test/test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_news {
+
+namespace {
+
+constexpr char kSourcesUrl[] = "https://brave-today-cdn.brave.com/sources.json";
+constexpr char kFeedUrl[] =
+    "https://brave-today-cdn.brave.com/brave-today/feed.json";
+constexpr char kArticleUrl[] = "https://www.example.com/an-article/";
+
+std::string GetSourcesJson() {
+  return R"([
+      {
+        "publisher_id": "111",
+        "publisher_name": "Test Publisher 1",
+        "category": "Top News",
+        "enabled": true
+      }
+    ])";
+}
+
+// A single top news article, published |age| before now.
+std::string GetFeedJson(base::TimeDelta age) {
+  base::Time::Exploded publish_time;
+  (base::Time::Now() - age).UTCExplode(&publish_time);
+  return base::StringPrintf(
+      R"([
+        {
+          "category": "Top News",
+          "publish_time": "%04d-%02d-%02d %02d:%02d:%02d",
+          "url": "%s",
+          "title": "An article",
+          "description": "",
+          "content_type": "article",
+          "publisher_id": "111",
+          "publisher_name": "Test Publisher 1",
+          "creative_instance_id": "",
+          "url_hash": "",
+          "padded_img": "https://pcdn.brave.com/brave-today/cache/1.jpg.pad",
+          "score": 13.9
+        }
+      ])",
+      publish_time.year, publish_time.month, publish_time.day_of_month,
+      publish_time.hour, publish_time.minute, publish_time.second,
+      kArticleUrl);
+}
+
+}  // namespace
+
+class FeedControllerTest : public testing::Test {
+ public:
+  FeedControllerTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        api_request_helper_(
+            TRAFFIC_ANNOTATION_FOR_TESTS,
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)),
+        direct_feed_controller_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {}
+  ~FeedControllerTest() override = default;
+
+  void SetUp() override {
+    BraveNewsController::RegisterProfilePrefs(prefs_.registry());
+    ASSERT_TRUE(history_dir_.CreateUniqueTempDir());
+    history_service_ = history::CreateHistoryService(history_dir_.GetPath(),
+                                                     /*create_db=*/true);
+    ASSERT_TRUE(history_service_);
+    publishers_controller_ =
+        std::make_unique<PublishersController>(&prefs_, &api_request_helper_);
+    feed_controller_ = std::make_unique<FeedController>(
+        publishers_controller_.get(), &direct_feed_controller_,
+        history_service_.get(), &api_request_helper_);
+
+    url_loader_factory_.AddResponse(kSourcesUrl, GetSourcesJson());
+  }
+
+  void TearDown() override {
+    feed_controller_.reset();
+    publishers_controller_.reset();
+    history_service_.reset();
+    task_environment_.RunUntilIdle();
+  }
+
+  void SetFeedResponse(const std::string& etag, const std::string& body) {
+    auto head = network::CreateURLResponseHead(net::HTTP_OK);
+    head->headers->AddHeader("etag", etag);
+    url_loader_factory_.AddResponse(GURL(kFeedUrl), std::move(head), body,
+                                    network::URLLoaderCompletionStatus());
+  }
+
+  mojom::FeedPtr GetFeed() {
+    mojom::FeedPtr result;
+    feed_controller_->GetOrFetchFeed(
+        base::BindLambdaForTesting([&](mojom::FeedPtr feed) {
+          result = std::move(feed);
+        }));
+    task_environment_.RunUntilIdle();
+    return result;
+  }
+
+  // Rebuilds the feed as when the user enables or disables a publisher.
+  mojom::FeedPtr RebuildFeed() {
+    feed_controller_->OnPublishersUpdated(publishers_controller_.get());
+    task_environment_.RunUntilIdle();
+    return GetFeed();
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  data_decoder::test::InProcessDataDecoder in_process_data_decoder_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  TestingPrefServiceSimple prefs_;
+  base::ScopedTempDir history_dir_;
+  std::unique_ptr<history::HistoryService> history_service_;
+  api_request_helper::APIRequestHelper api_request_helper_;
+  DirectFeedController direct_feed_controller_;
+  std::unique_ptr<PublishersController> publishers_controller_;
+  std::unique_ptr<FeedController> feed_controller_;
+};
+
+// The feed is parsed and built on the thread pool, the result comes back to
+// the UI thread with its relative times formatted there.
+TEST_F(FeedControllerTest, BuildsFeedInBackground) {
+  SetFeedResponse("\"1\"", GetFeedJson(base::Hours(1)));
+
+  mojom::FeedPtr feed = GetFeed();
+  ASSERT_TRUE(feed);
+  EXPECT_FALSE(feed->hash.empty());
+  ASSERT_TRUE(feed->featured_item);
+  ASSERT_TRUE(feed->featured_item->is_article());
+  const auto& data = feed->featured_item->get_article()->data;
+  EXPECT_EQ(data->url, GURL(kArticleUrl));
+  EXPECT_FALSE(data->relative_time_description.empty());
+}
+
+// Rebuilding from the items parsed for an unchanged ETag formats the
+// relative times again instead of keeping the ones from the first parse.
+TEST_F(FeedControllerTest, ReusedItemsGetFreshRelativeTimes) {
+  SetFeedResponse("\"1\"", GetFeedJson(base::Hours(1)));
+  mojom::FeedPtr feed = GetFeed();
+  ASSERT_TRUE(feed && feed->featured_item);
+  const std::string first_description =
+      feed->featured_item->get_article()->data->relative_time_description;
+
+  task_environment_.AdvanceClock(base::Hours(5));
+  // Same ETag, the body is not parsed again. A different body makes sure of
+  // that: its article would be one hour old.
+  SetFeedResponse("\"1\"", GetFeedJson(base::Hours(1)));
+  feed = RebuildFeed();
+  ASSERT_TRUE(feed && feed->featured_item);
+  EXPECT_NE(feed->featured_item->get_article()->data->relative_time_description,
+            first_description);
+}
+
+}  // namespace brave_news
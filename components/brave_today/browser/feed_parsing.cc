@@ -74,15 +74,6 @@ bool ParseFeedItem(const base::Value& feed_item_raw,
       (*feed_item_raw.FindStringKey("publish_time")).c_str();
   if (!base::Time::FromUTCString(publish_time_raw, &metadata->publish_time)) {
     VLOG(1) << "bad time string for feed item: " << publish_time_raw;
-  } else {
-    // Successful, get language-specific relative time
-    base::TimeDelta relative_time_delta =
-        base::Time::Now() - metadata->publish_time;
-    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
-    metadata->relative_time_description =
-        converter.to_bytes(ui::TimeFormat::Simple(
-            ui::TimeFormat::Format::FORMAT_ELAPSED,
-            ui::TimeFormat::Length::LENGTH_LONG, relative_time_delta));
   }
   // Detect type
   auto content_type = *feed_item_raw.FindStringKey("content_type");
@@ -114,6 +105,18 @@ bool ParseFeedItem(const base::Value& feed_item_raw,
   return true;
 }
 
+mojom::FeedItemMetadataPtr& MetadataFromFeedItem(
+    const mojom::FeedItemPtr& item) {
+  switch (item->which()) {
+    case mojom::FeedItem::Tag::kArticle:
+      return item->get_article()->data;
+    case mojom::FeedItem::Tag::kDeal:
+      return item->get_deal()->data;
+    case mojom::FeedItem::Tag::kPromotedArticle:
+      return item->get_promoted_article()->data;
+  }
+}
+
 }  // namespace
 
 bool ParseFeedItems(const std::string& json,
@@ -139,4 +142,19 @@ bool ParseFeedItems(const std::string& json,
   return true;
 }
 
+void SetRelativeTimeDescriptions(std::vector<mojom::FeedItemPtr>* feed_items) {
+  const base::Time now = base::Time::Now();
+  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
+  for (const auto& item : *feed_items) {
+    auto& metadata = MetadataFromFeedItem(item);
+    if (metadata->publish_time.is_null())
+      continue;
+    // Get language-specific relative time
+    metadata->relative_time_description =
+        converter.to_bytes(ui::TimeFormat::Simple(
+            ui::TimeFormat::Format::FORMAT_ELAPSED,
+            ui::TimeFormat::Length::LENGTH_LONG, now - metadata->publish_time));
+  }
+}
+
 }  // namespace brave_news
@@ -14,9 +14,14 @@
 
 namespace brave_news {
 
+// Safe to call on any sequence, relative times are left empty.
 bool ParseFeedItems(const std::string& json,
                     std::vector<mojom::FeedItemPtr>* feed_items);
 
+// Fills in the localized "N hours ago" description of each item as of now.
+// Reads the string resources, so it must be called on the UI thread.
+void SetRelativeTimeDescriptions(std::vector<mojom::FeedItemPtr>* feed_items);
+
 }  // namespace brave_news
 
 #endif  // BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_FEED_PARSING_H_
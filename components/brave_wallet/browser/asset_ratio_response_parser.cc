@@ -22,6 +22,22 @@ bool ParseAssetPrice(const std::string& json,
                      const std::vector<std::string>& from_assets,
                      const std::vector<std::string>& to_assets,
                      std::vector<mojom::AssetPricePtr>* values) {
+  base::JSONReader::ValueWithError value_with_error =
+      base::JSONReader::ReadAndReturnValueWithError(
+          json, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
+                    base::JSONParserOptions::JSON_PARSE_RFC);
+  absl::optional<base::Value>& records_v = value_with_error.value;
+  if (!records_v) {
+    LOG(ERROR) << "Invalid response, could not parse JSON, JSON is: " << json;
+    return false;
+  }
+  return ParseAssetPrice(*records_v, from_assets, to_assets, values);
+}
+
+bool ParseAssetPrice(const base::Value& json_value,
+                     const std::vector<std::string>& from_assets,
+                     const std::vector<std::string>& to_assets,
+                     std::vector<mojom::AssetPricePtr>* values) {
   // Parses results like this:
   // /v2/relative/provider/coingecko/bat,chainlink/btc,usd/1w
   // {
@@ -44,18 +60,8 @@ bool ParseAssetPrice(const std::string& json,
 
   DCHECK(values);
 
-  base::JSONReader::ValueWithError value_with_error =
-      base::JSONReader::ReadAndReturnValueWithError(
-          json, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
-                    base::JSONParserOptions::JSON_PARSE_RFC);
-  absl::optional<base::Value>& records_v = value_with_error.value;
-  if (!records_v) {
-    LOG(ERROR) << "Invalid response, could not parse JSON, JSON is: " << json;
-    return false;
-  }
-
   const base::DictionaryValue* response_dict;
-  if (!records_v->GetAsDictionary(&response_dict)) {
+  if (!json_value.GetAsDictionary(&response_dict)) {
     return false;
   }
 
@@ -108,16 +114,6 @@ bool ParseAssetPrice(const std::string& json,
 
 bool ParseAssetPriceHistory(const std::string& json,
                             std::vector<mojom::AssetTimePricePtr>* values) {
-  DCHECK(values);
-
-  // {  "payload":
-  //   {
-  //     "prices":[[1622733088498,0.8201346624954003],[1622737203757,0.8096978545029869]],
-  //     "market_caps":[[1622733088498,1223507820.383275],[1622737203757,1210972881.4928021]],
-  //     "total_volumes":[[1622733088498,163426828.00299588],[1622737203757,157618689.0971025]]
-  //   }
-  // }
-
   base::JSONReader::ValueWithError value_with_error =
       base::JSONReader::ReadAndReturnValueWithError(
           json, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
@@ -127,9 +123,23 @@ bool ParseAssetPriceHistory(const std::string& json,
     LOG(ERROR) << "Invalid response, could not parse JSON, JSON is: " << json;
     return false;
   }
+  return ParseAssetPriceHistory(*records_v, values);
+}
+
+bool ParseAssetPriceHistory(const base::Value& json_value,
+                            std::vector<mojom::AssetTimePricePtr>* values) {
+  DCHECK(values);
+
+  // {  "payload":
+  //   {
+  //     "prices":[[1622733088498,0.8201346624954003],[1622737203757,0.8096978545029869]],
+  //     "market_caps":[[1622733088498,1223507820.383275],[1622737203757,1210972881.4928021]],
+  //     "total_volumes":[[1622733088498,163426828.00299588],[1622737203757,157618689.0971025]]
+  //   }
+  // }
 
   const base::DictionaryValue* response_dict;
-  if (!records_v->GetAsDictionary(&response_dict)) {
+  if (!json_value.GetAsDictionary(&response_dict)) {
     return false;
   }
 
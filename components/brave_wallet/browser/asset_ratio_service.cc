@@ -174,7 +174,7 @@ void AssetRatioService::GetPrice(
   }
   request_headers["x-brave-key"] = std::move(brave_key);
 
-  api_request_helper_->Request(
+  api_request_helper_->RequestJson(
       "GET", GetPriceURL(from_assets_lower, to_assets_lower, timeframe), "", "",
       true, std::move(internal_callback), request_headers);
 }
@@ -184,7 +184,7 @@ void AssetRatioService::OnGetPrice(
     std::vector<std::string> to_assets,
     GetPriceCallback callback,
     const int status,
-    const std::string& body,
+    base::Value body,
     const base::flat_map<std::string, std::string>& headers) {
   std::vector<brave_wallet::mojom::AssetPricePtr> prices;
   if (status < 200 || status > 299) {
@@ -209,7 +209,7 @@ void AssetRatioService::GetPriceHistory(
   auto internal_callback =
       base::BindOnce(&AssetRatioService::OnGetPriceHistory,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  api_request_helper_->Request(
+  api_request_helper_->RequestJson(
       "GET", GetPriceHistoryURL(asset_lower, vs_asset_lower, timeframe), "", "",
       true, std::move(internal_callback));
 }
@@ -217,7 +217,7 @@ void AssetRatioService::GetPriceHistory(
 void AssetRatioService::OnGetPriceHistory(
     GetPriceHistoryCallback callback,
     const int status,
-    const std::string& body,
+    base::Value body,
     const base::flat_map<std::string, std::string>& headers) {
   std::vector<brave_wallet::mojom::AssetTimePricePtr> values;
   if (status < 200 || status > 299) {
@@ -14,6 +14,7 @@
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
+#include "base/values.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/asset_ratio_response_parser.h"
 #include "url/gurl.h"
@@ -76,12 +77,12 @@ class AssetRatioService : public KeyedService, public mojom::AssetRatioService {
                   std::vector<std::string> to_assets,
                   GetPriceCallback callback,
                   const int status,
-                  const std::string& body,
+                  base::Value body,
                   const base::flat_map<std::string, std::string>& headers);
   void OnGetPriceHistory(
       GetPriceHistoryCallback callback,
       const int status,
-      const std::string& body,
+      base::Value body,
       const base::flat_map<std::string, std::string>& headers);
 
   void OnGetEstimatedTime(
@@ -8,11 +8,30 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 
 namespace brave_wallet {
 
+namespace {
+
+// EVM addresses are hex and may come checksummed, Solana mint addresses are
+// base58 where case matters.
+std::string GetContractKey(const std::string& contract) {
+  if (base::StartsWith(contract, "0x", base::CompareCase::INSENSITIVE_ASCII))
+    return base::ToLowerASCII(contract);
+  return contract;
+}
+
+}  // namespace
+
+BlockchainRegistry::TokenIndex::TokenIndex() = default;
+BlockchainRegistry::TokenIndex::~TokenIndex() = default;
+BlockchainRegistry::TokenIndex::TokenIndex(TokenIndex&&) = default;
+BlockchainRegistry::TokenIndex& BlockchainRegistry::TokenIndex::operator=(
+    TokenIndex&&) = default;
+
 BlockchainRegistry::BlockchainRegistry() = default;
 
 BlockchainRegistry::~BlockchainRegistry() {}
@@ -35,6 +54,40 @@ void BlockchainRegistry::Bind(
 
 void BlockchainRegistry::UpdateTokenList(TokenListMap token_list_map) {
   token_list_map_ = std::move(token_list_map);
+  std::vector<std::pair<std::string, TokenIndex>> token_indexes;
+  for (const auto& chain_tokens : token_list_map_) {
+    const auto& tokens = chain_tokens.second;
+    std::vector<std::pair<std::string, size_t>> by_contract;
+    std::vector<std::pair<std::string, size_t>> by_symbol;
+    by_contract.reserve(tokens.size());
+    by_symbol.reserve(tokens.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      by_contract.emplace_back(GetContractKey(tokens[i]->contract_address), i);
+      by_symbol.emplace_back(tokens[i]->symbol, i);
+    }
+    // Building the flat maps at once keeps the first entry of duplicated
+    // keys, like the list scans used to.
+    TokenIndex index;
+    index.by_contract =
+        base::flat_map<std::string, size_t>(std::move(by_contract));
+    index.by_symbol = base::flat_map<std::string, size_t>(std::move(by_symbol));
+    token_indexes.emplace_back(chain_tokens.first, std::move(index));
+  }
+  token_indexes_ =
+      base::flat_map<std::string, TokenIndex>(std::move(token_indexes));
+}
+
+const mojom::BlockchainTokenPtr* BlockchainRegistry::FindTokenByContract(
+    const std::string& chain_id,
+    const std::string& contract) const {
+  auto index_it = token_indexes_.find(chain_id);
+  if (index_it == token_indexes_.end())
+    return nullptr;
+  const auto& by_contract = index_it->second.by_contract;
+  auto it = by_contract.find(GetContractKey(contract));
+  if (it == by_contract.end())
+    return nullptr;
+  return &token_list_map_.at(chain_id)[it->second];
 }
 
 void BlockchainRegistry::GetTokenByContract(
@@ -47,38 +100,45 @@ void BlockchainRegistry::GetTokenByContract(
 mojom::BlockchainTokenPtr BlockchainRegistry::GetTokenByContract(
     const std::string& chain_id,
     const std::string& contract) {
-  if (token_list_map_.find(chain_id) == token_list_map_.end())
-    return nullptr;
+  const auto* token = FindTokenByContract(chain_id, contract);
+  return token ? token->Clone() : nullptr;
+}
 
-  const auto& tokens = token_list_map_[chain_id];
-  auto token_it =
-      std::find_if(tokens.begin(), tokens.end(),
-                   [&](const mojom::BlockchainTokenPtr& current_token) {
-                     return current_token->contract_address == contract;
-                   });
-  return token_it == tokens.end() ? nullptr : token_it->Clone();
+void BlockchainRegistry::GetTokensByContracts(
+    const std::string& chain_id,
+    const std::vector<std::string>& contracts,
+    GetTokensByContractsCallback callback) {
+  std::move(callback).Run(GetTokensByContracts(chain_id, contracts));
+}
+
+std::vector<mojom::BlockchainTokenPtr> BlockchainRegistry::GetTokensByContracts(
+    const std::string& chain_id,
+    const std::vector<std::string>& contracts) {
+  std::vector<mojom::BlockchainTokenPtr> tokens;
+  tokens.reserve(contracts.size());
+  for (const auto& contract : contracts) {
+    const auto* token = FindTokenByContract(chain_id, contract);
+    tokens.push_back(token ? token->Clone() : nullptr);
+  }
+  return tokens;
 }
 
 void BlockchainRegistry::GetTokenBySymbol(const std::string& chain_id,
                                           const std::string& symbol,
                                           GetTokenBySymbolCallback callback) {
-  if (token_list_map_.find(chain_id) == token_list_map_.end()) {
+  auto index_it = token_indexes_.find(chain_id);
+  if (index_it == token_indexes_.end()) {
     std::move(callback).Run(nullptr);
     return;
   }
-  const auto& tokens = token_list_map_[chain_id];
-  auto token_it =
-      std::find_if(tokens.begin(), tokens.end(),
-                   [&](const mojom::BlockchainTokenPtr& current_token) {
-                     return current_token->symbol == symbol;
-                   });
-
-  if (token_it == tokens.end()) {
+  const auto& by_symbol = index_it->second.by_symbol;
+  auto it = by_symbol.find(symbol);
+  if (it == by_symbol.end()) {
     std::move(callback).Run(nullptr);
     return;
   }
 
-  std::move(callback).Run(token_it->Clone());
+  std::move(callback).Run(token_list_map_[chain_id][it->second].Clone());
 }
 
 void BlockchainRegistry::GetAllTokens(const std::string& chain_id,
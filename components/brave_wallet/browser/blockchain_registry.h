@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/memory/singleton.h"
 #include "brave/components/brave_wallet/browser/blockchain_list_parser.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
@@ -31,13 +32,23 @@ class BlockchainRegistry : public mojom::BlockchainRegistry {
 
   void UpdateTokenList(TokenListMap tokens);
 
+  // EVM contract addresses are matched case-insensitively, Solana mint
+  // addresses are case-sensitive base58 and must match exactly.
   mojom::BlockchainTokenPtr GetTokenByContract(const std::string& chain_id,
                                                const std::string& contract);
+  // Resolves many contracts with one call, the result is in the order of
+  // |contracts| and holds nullptr for unknown contracts.
+  std::vector<mojom::BlockchainTokenPtr> GetTokensByContracts(
+      const std::string& chain_id,
+      const std::vector<std::string>& contracts);
 
   // BlockchainRegistry interface methods
   void GetTokenByContract(const std::string& chain_id,
                           const std::string& contract,
                           GetTokenByContractCallback callback) override;
+  void GetTokensByContracts(const std::string& chain_id,
+                            const std::vector<std::string>& contracts,
+                            GetTokensByContractsCallback callback) override;
   void GetTokenBySymbol(const std::string& chain_id,
                         const std::string& symbol,
                         GetTokenBySymbolCallback callback) override;
@@ -61,6 +72,27 @@ class BlockchainRegistry : public mojom::BlockchainRegistry {
   BlockchainRegistry();
 
  private:
+  // Built by UpdateTokenList so lookups don't scan the token list, which
+  // holds over a thousand mainnet tokens.
+  struct TokenIndex {
+    TokenIndex();
+    ~TokenIndex();
+    TokenIndex(TokenIndex&&);
+    TokenIndex& operator=(TokenIndex&&);
+
+    // <contract address as returned by GetContractKey, position in the
+    // chain's token list>
+    base::flat_map<std::string, size_t> by_contract;
+    // <symbol, position of the first token with that symbol>
+    base::flat_map<std::string, size_t> by_symbol;
+  };
+
+  const mojom::BlockchainTokenPtr* FindTokenByContract(
+      const std::string& chain_id,
+      const std::string& contract) const;
+
+  // <chain_id, index of token_list_map_[chain_id]>
+  base::flat_map<std::string, TokenIndex> token_indexes_;
   mojo::ReceiverSet<mojom::BlockchainRegistry> receivers_;
 };
 
@@ -7,8 +7,12 @@
 #include <utility>
 #include <vector>
 
+#include "base/logging.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/test/bind.h"
 #include "base/test/task_environment.h"
+#include "base/timer/elapsed_timer.h"
 #include "brave/components/brave_wallet/browser/blockchain_list_parser.h"
 #include "brave/components/brave_wallet/browser/blockchain_registry.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -165,6 +169,119 @@ TEST(BlockchainRegistryUnitTest, GetTokenByContract) {
         run_loop4.Quit();
       }));
   run_loop4.Run();
+
+  // Contracts are matched regardless of their checksum casing
+  auto token = registry->GetTokenByContract(
+      mojom::kMainnetChainId, "0x0d8775f648430679a709e98d2b0cb6250d2887ef");
+  ASSERT_TRUE(token);
+  EXPECT_EQ(token->symbol, "BAT");
+  EXPECT_EQ(token->contract_address,
+            "0x0D8775F648430679A709E98d2b0Cb6250d2887EF");
+}
+
+TEST(BlockchainRegistryUnitTest, GetTokensByContracts) {
+  base::test::TaskEnvironment task_environment;
+  auto* registry = BlockchainRegistry::GetInstance();
+  TokenListMap token_list_map;
+  ASSERT_TRUE(ParseTokenList(token_list_json, &token_list_map));
+  registry->UpdateTokenList(std::move(token_list_map));
+
+  base::RunLoop run_loop;
+  registry->GetTokensByContracts(
+      mojom::kMainnetChainId,
+      {"0x0D8775F648430679A709E98d2b0Cb6250d2887EF",
+       "0xCCC775F648430679A709E98d2b0Cb6250d2887EF",
+       "0x06012c8cf97bead5deae237070f9587f8e7a266d",
+       "0x1f9840a85d5aF5bf1D1762F925BDADdC4201F984"},
+      base::BindLambdaForTesting(
+          [&](std::vector<mojom::BlockchainTokenPtr> tokens) {
+            ASSERT_EQ(tokens.size(), 4UL);
+            ASSERT_TRUE(tokens[0]);
+            EXPECT_EQ(tokens[0]->symbol, "BAT");
+            EXPECT_FALSE(tokens[1]);
+            ASSERT_TRUE(tokens[2]);
+            EXPECT_EQ(tokens[2]->symbol, "CK");
+            // Uniswap is only listed for Ropsten
+            EXPECT_FALSE(tokens[3]);
+            run_loop.Quit();
+          }));
+  run_loop.Run();
+
+  EXPECT_TRUE(
+      registry->GetTokensByContracts(mojom::kMainnetChainId, {}).empty());
+  auto tokens = registry->GetTokensByContracts(
+      mojom::kRinkebyChainId, {"0x0D8775F648430679A709E98d2b0Cb6250d2887EF"});
+  ASSERT_EQ(tokens.size(), 1UL);
+  EXPECT_FALSE(tokens[0]);
+}
+
+// Solana mint addresses are case-sensitive base58.
+TEST(BlockchainRegistryUnitTest, SolanaMintsAreCaseSensitive) {
+  base::test::TaskEnvironment task_environment;
+  auto* registry = BlockchainRegistry::GetInstance();
+  const std::string mint = "AQoKYV7tYpTrFZN6P5oUufbQKAUr9mNYGe1TTJC9wajM";
+  const std::string other_mint = base::ToLowerASCII(mint);
+  TokenListMap token_list_map;
+  token_list_map[mojom::kSolanaMainnet].push_back(mojom::BlockchainToken::New(
+      mint, "Token", "", false, false, "TKN", 9, true, "", "",
+      mojom::kSolanaMainnet));
+  token_list_map[mojom::kSolanaMainnet].push_back(mojom::BlockchainToken::New(
+      other_mint, "Other token", "", false, false, "OTHER", 9, true, "", "",
+      mojom::kSolanaMainnet));
+  registry->UpdateTokenList(std::move(token_list_map));
+
+  auto tokens = registry->GetTokensByContracts(
+      mojom::kSolanaMainnet, {mint, other_mint, base::ToUpperASCII(mint)});
+  ASSERT_EQ(tokens.size(), 3UL);
+  ASSERT_TRUE(tokens[0]);
+  EXPECT_EQ(tokens[0]->symbol, "TKN");
+  ASSERT_TRUE(tokens[1]);
+  EXPECT_EQ(tokens[1]->symbol, "OTHER");
+  EXPECT_FALSE(tokens[2]);
+}
+
+// Resolves a portfolio against a token list the size of the mainnet one.
+TEST(BlockchainRegistryUnitTest, LookupsOnFullTokenList) {
+  base::test::TaskEnvironment task_environment;
+  constexpr size_t kTokenCount = 2000;
+  TokenListMap token_list_map;
+  auto& tokens = token_list_map[mojom::kMainnetChainId];
+  std::vector<std::string> contracts;
+  for (size_t i = 0; i < kTokenCount; ++i) {
+    auto token = mojom::BlockchainToken::New();
+    token->contract_address = base::StringPrintf("0x%040zX", i);
+    token->symbol = base::StringPrintf("TKN%zu", i);
+    token->is_erc20 = true;
+    token->decimals = 18;
+    contracts.push_back(base::ToLowerASCII(token->contract_address));
+    tokens.push_back(std::move(token));
+  }
+  auto* registry = BlockchainRegistry::GetInstance();
+  base::ElapsedTimer update_timer;
+  registry->UpdateTokenList(std::move(token_list_map));
+  const base::TimeDelta update = update_timer.Elapsed();
+
+  base::ElapsedTimer lookups_timer;
+  auto found =
+      registry->GetTokensByContracts(mojom::kMainnetChainId, contracts);
+  ASSERT_EQ(found.size(), kTokenCount);
+  for (size_t i = 0; i < kTokenCount; ++i) {
+    ASSERT_TRUE(found[i]);
+    EXPECT_EQ(found[i]->symbol, base::StringPrintf("TKN%zu", i));
+  }
+
+  base::RunLoop run_loop;
+  registry->GetTokenBySymbol(
+      mojom::kMainnetChainId, base::StringPrintf("TKN%zu", kTokenCount - 1),
+      base::BindLambdaForTesting([&](mojom::BlockchainTokenPtr token) {
+        ASSERT_TRUE(token);
+        EXPECT_EQ(base::ToLowerASCII(token->contract_address),
+                  contracts.back());
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+  VLOG(1) << "Indexing " << kTokenCount << " tokens: " << update << ", "
+          << kTokenCount << " lookups: " << lookups_timer.Elapsed();
 }
 
 TEST(BlockchainRegistryUnitTest, GetTokenBySymbol) {
@@ -248,24 +248,25 @@ absl::optional<Eip1559Transaction> Eip1559Transaction::FromValue(
 std::vector<uint8_t> Eip1559Transaction::GetMessageToSign(uint256_t chain_id,
                                                           bool hash) const {
   DCHECK(nonce_);
+  RLPWriter writer;
+  writer.Reserve(data_.size() + GetAccessListSize(access_list_) +
+                 kRLPFieldsReserve);
+  writer.BeginList();
+  writer.AddUint256(chain_id_);
+  writer.AddUint256(nonce_.value());
+  writer.AddUint256(max_priority_fee_per_gas_);
+  writer.AddUint256(max_fee_per_gas_);
+  writer.AddUint256(gas_limit_);
+  writer.AddBytes(to_.bytes());
+  writer.AddUint256(value_);
+  writer.AddBytes(data_);
+  AccessListToRLP(access_list_, &writer);
+  writer.EndList();
+
   std::vector<uint8_t> result;
+  result.reserve(writer.output().size() + 1);
   result.push_back(type_);
-
-  // TODO(darkdh): Migrate to std::vector<base::Value>, base::ListValue is
-  // deprecated
-  base::ListValue list;
-  list.Append(RLPUint256ToBlobValue(chain_id_));
-  list.Append(RLPUint256ToBlobValue(nonce_.value()));
-  list.Append(RLPUint256ToBlobValue(max_priority_fee_per_gas_));
-  list.Append(RLPUint256ToBlobValue(max_fee_per_gas_));
-  list.Append(RLPUint256ToBlobValue(gas_limit_));
-  list.Append(base::Value(to_.bytes()));
-  list.Append(RLPUint256ToBlobValue(value_));
-  list.Append(base::Value(data_));
-  list.Append(base::Value(AccessListToValue(access_list_)));
-
-  const std::string rlp_msg = RLPEncode(std::move(list));
-  result.insert(result.end(), rlp_msg.begin(), rlp_msg.end());
+  result.insert(result.end(), writer.output().begin(), writer.output().end());
   return hash ? KeccakHash(result) : result;
 }
 
@@ -273,27 +274,28 @@ std::string Eip1559Transaction::GetSignedTransaction() const {
   DCHECK(IsSigned());
   DCHECK(nonce_);
 
-  // TODO(darkdh): Migrate to std::vector<base::Value>, base::ListValue is
-  // deprecated
-  base::ListValue list;
-  list.Append(RLPUint256ToBlobValue(chain_id_));
-  list.Append(RLPUint256ToBlobValue(nonce_.value()));
-  list.Append(RLPUint256ToBlobValue(max_priority_fee_per_gas_));
-  list.Append(RLPUint256ToBlobValue(max_fee_per_gas_));
-  list.Append(RLPUint256ToBlobValue(gas_limit_));
-  list.Append(base::Value(to_.bytes()));
-  list.Append(RLPUint256ToBlobValue(value_));
-  list.Append(base::Value(data_));
-  list.Append(base::Value(AccessListToValue(access_list_)));
-  list.Append(RLPUint256ToBlobValue(v_));
-  list.Append(base::Value(r_));
-  list.Append(base::Value(s_));
+  RLPWriter writer;
+  writer.Reserve(data_.size() + GetAccessListSize(access_list_) +
+                 kRLPFieldsReserve);
+  writer.BeginList();
+  writer.AddUint256(chain_id_);
+  writer.AddUint256(nonce_.value());
+  writer.AddUint256(max_priority_fee_per_gas_);
+  writer.AddUint256(max_fee_per_gas_);
+  writer.AddUint256(gas_limit_);
+  writer.AddBytes(to_.bytes());
+  writer.AddUint256(value_);
+  writer.AddBytes(data_);
+  AccessListToRLP(access_list_, &writer);
+  writer.AddUint256(v_);
+  writer.AddBytes(r_);
+  writer.AddBytes(s_);
+  writer.EndList();
 
   std::vector<uint8_t> result;
+  result.reserve(writer.output().size() + 1);
   result.push_back(type_);
-
-  const std::string rlp_msg = RLPEncode(std::move(list));
-  result.insert(result.end(), rlp_msg.begin(), rlp_msg.end());
+  result.insert(result.end(), writer.output().begin(), writer.output().end());
 
   return ToHex(result);
 }
@@ -3,13 +3,19 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/eip1559_transaction.h"
 #include "brave/components/brave_wallet/browser/internal/hd_key.h"
+#include "brave/components/brave_wallet/browser/rlp_encode.h"
+#include "brave/components/brave_wallet/common/hash_utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_wallet {
@@ -338,4 +344,59 @@ TEST(Eip1559TransactionUnitTest, GasEstimationToMojomGasEstimation1559) {
       GetMojomGasEstimation());
 }
 
+// Builds the message to sign of a transaction with 128KB of calldata and
+// compares it with building a base::Value list and RLP encoding that.
+TEST(Eip1559TransactionUnitTest, LargeCalldataMessageToSign) {
+  constexpr size_t kDataSize = 128 * 1024;
+  constexpr int kIterations = 100;
+  std::vector<uint8_t> data(kDataSize);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i);
+  Eip1559Transaction tx =
+      *Eip1559Transaction::FromTxData(mojom::TxData1559::New(
+          mojom::TxData::New("0x09", "0x00", "0x5208",
+                             "0x0101010101010101010101010101010101010101",
+                             "0xde0b6b3a7640000", data),
+          "0x1", "0x3b9aca00", "0xb2d05e000", nullptr));
+  Eip2930Transaction::AccessListItem item;
+  item.address.fill(0x01);
+  Eip2930Transaction::AccessedStorageKey storage_key;
+  storage_key.fill(0x01);
+  item.storage_keys.push_back(storage_key);
+  tx.access_list()->push_back(item);
+
+  base::ElapsedTimer value_timer;
+  std::vector<uint8_t> value_message;
+  for (int i = 0; i < kIterations; ++i) {
+    base::ListValue list;
+    list.Append(RLPUint256ToBlobValue(tx.chain_id()));
+    list.Append(RLPUint256ToBlobValue(tx.nonce().value()));
+    list.Append(RLPUint256ToBlobValue(tx.max_priority_fee_per_gas()));
+    list.Append(RLPUint256ToBlobValue(tx.max_fee_per_gas()));
+    list.Append(RLPUint256ToBlobValue(tx.gas_limit()));
+    list.Append(base::Value(tx.to().bytes()));
+    list.Append(RLPUint256ToBlobValue(tx.value()));
+    list.Append(base::Value(tx.data()));
+    list.Append(base::Value(
+        Eip2930Transaction::AccessListToValue(*tx.access_list())));
+    const std::string rlp_msg = RLPEncode(std::move(list));
+    value_message = {tx.type()};
+    value_message.insert(value_message.end(), rlp_msg.begin(), rlp_msg.end());
+  }
+  const base::TimeDelta value_time = value_timer.Elapsed();
+
+  base::ElapsedTimer writer_timer;
+  std::vector<uint8_t> message;
+  for (int i = 0; i < kIterations; ++i)
+    message = tx.GetMessageToSign(0, false);
+  const base::TimeDelta writer_time = writer_timer.Elapsed();
+
+  VLOG(1) << "Message to sign of " << kDataSize << " bytes of calldata took "
+          << value_time / kIterations << " through base::Value, "
+          << writer_time / kIterations << " with RLPWriter";
+
+  EXPECT_EQ(message, value_message);
+  EXPECT_EQ(tx.GetMessageToSign(), KeccakHash(value_message));
+}
+
 }  // namespace brave_wallet
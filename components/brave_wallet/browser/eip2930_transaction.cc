@@ -151,26 +151,56 @@ Eip2930Transaction::ValueToAccessList(const base::Value& value) {
   return access_list;
 }
 
+// static
+void Eip2930Transaction::AccessListToRLP(const AccessList& access_list,
+                                         RLPWriter* writer) {
+  writer->BeginList();
+  for (const auto& item : access_list) {
+    writer->BeginList();
+    writer->AddBytes(item.address);
+    writer->BeginList();
+    for (const auto& key : item.storage_keys)
+      writer->AddBytes(key);
+    writer->EndList();
+    writer->EndList();
+  }
+  writer->EndList();
+}
+
+// static
+size_t Eip2930Transaction::GetAccessListSize(const AccessList& access_list) {
+  size_t size = RLPWriter::kMaxLengthPrefixSize;
+  for (const auto& item : access_list) {
+    // The item's list and its storage keys' list
+    size += 2 * RLPWriter::kMaxLengthPrefixSize + 1 +
+            std::tuple_size<AccessedAddress>::value +
+            item.storage_keys.size() *
+                (1 + std::tuple_size<AccessedStorageKey>::value);
+  }
+  return size;
+}
+
 std::vector<uint8_t> Eip2930Transaction::GetMessageToSign(uint256_t chain_id,
                                                           bool hash) const {
   DCHECK(nonce_);
+  RLPWriter writer;
+  writer.Reserve(data_.size() + GetAccessListSize(access_list_) +
+                 kRLPFieldsReserve);
+  writer.BeginList();
+  writer.AddUint256(chain_id_);
+  writer.AddUint256(nonce_.value());
+  writer.AddUint256(gas_price_);
+  writer.AddUint256(gas_limit_);
+  writer.AddBytes(to_.bytes());
+  writer.AddUint256(value_);
+  writer.AddBytes(data_);
+  AccessListToRLP(access_list_, &writer);
+  writer.EndList();
+
   std::vector<uint8_t> result;
+  result.reserve(writer.output().size() + 1);
   result.push_back(type_);
-
-  // TODO(darkdh): Migrate to std::vector<base::Value>, base::ListValue is
-  // deprecated
-  base::ListValue list;
-  list.Append(RLPUint256ToBlobValue(chain_id_));
-  list.Append(RLPUint256ToBlobValue(nonce_.value()));
-  list.Append(RLPUint256ToBlobValue(gas_price_));
-  list.Append(RLPUint256ToBlobValue(gas_limit_));
-  list.Append(base::Value(to_.bytes()));
-  list.Append(RLPUint256ToBlobValue(value_));
-  list.Append(base::Value(data_));
-  list.Append(base::Value(AccessListToValue(access_list_)));
-
-  const std::string rlp_msg = RLPEncode(std::move(list));
-  result.insert(result.end(), rlp_msg.begin(), rlp_msg.end());
+  result.insert(result.end(), writer.output().begin(), writer.output().end());
   return hash ? KeccakHash(result) : result;
 }
 
@@ -178,26 +208,27 @@ std::string Eip2930Transaction::GetSignedTransaction() const {
   DCHECK(IsSigned());
   DCHECK(nonce_);
 
-  // TODO(darkdh): Migrate to std::vector<base::Value>, base::ListValue is
-  // deprecated
-  base::ListValue list;
-  list.Append(RLPUint256ToBlobValue(chain_id_));
-  list.Append(RLPUint256ToBlobValue(nonce_.value()));
-  list.Append(RLPUint256ToBlobValue(gas_price_));
-  list.Append(RLPUint256ToBlobValue(gas_limit_));
-  list.Append(base::Value(to_.bytes()));
-  list.Append(RLPUint256ToBlobValue(value_));
-  list.Append(base::Value(data_));
-  list.Append(base::Value(AccessListToValue(access_list_)));
-  list.Append(RLPUint256ToBlobValue(v_));
-  list.Append(base::Value(r_));
-  list.Append(base::Value(s_));
+  RLPWriter writer;
+  writer.Reserve(data_.size() + GetAccessListSize(access_list_) +
+                 kRLPFieldsReserve);
+  writer.BeginList();
+  writer.AddUint256(chain_id_);
+  writer.AddUint256(nonce_.value());
+  writer.AddUint256(gas_price_);
+  writer.AddUint256(gas_limit_);
+  writer.AddBytes(to_.bytes());
+  writer.AddUint256(value_);
+  writer.AddBytes(data_);
+  AccessListToRLP(access_list_, &writer);
+  writer.AddUint256(v_);
+  writer.AddBytes(r_);
+  writer.AddBytes(s_);
+  writer.EndList();
 
   std::vector<uint8_t> result;
+  result.reserve(writer.output().size() + 1);
   result.push_back(type_);
-
-  const std::string rlp_msg = RLPEncode(std::move(list));
-  result.insert(result.end(), rlp_msg.begin(), rlp_msg.end());
+  result.insert(result.end(), writer.output().begin(), writer.output().end());
 
   return ToHex(result);
 }
@@ -15,6 +15,8 @@
 
 namespace brave_wallet {
 
+class RLPWriter;
+
 class Eip2930Transaction : public EthTransaction {
  public:
   typedef std::array<uint8_t, 20> AccessedAddress;
@@ -77,6 +79,13 @@ class Eip2930Transaction : public EthTransaction {
                      const std::vector<uint8_t>& data,
                      uint256_t chain_id);
 
+  // Writes the RLP list of |access_list| to |writer|
+  static void AccessListToRLP(const AccessList& access_list,
+                              RLPWriter* writer);
+  // Room for the RLP encoding of |access_list|, with up to
+  // RLPWriter::kMaxLengthPrefixSize bytes for the header of each of its lists
+  static size_t GetAccessListSize(const AccessList& access_list);
+
   uint256_t chain_id_;
   AccessList access_list_;
 };
@@ -153,38 +153,42 @@ absl::optional<EthTransaction> EthTransaction::FromValue(
 std::vector<uint8_t> EthTransaction::GetMessageToSign(uint256_t chain_id,
                                                       bool hash) const {
   DCHECK(nonce_);
-  base::ListValue list;
-  list.Append(RLPUint256ToBlobValue(nonce_.value()));
-  list.Append(RLPUint256ToBlobValue(gas_price_));
-  list.Append(RLPUint256ToBlobValue(gas_limit_));
-  list.Append(base::Value(to_.bytes()));
-  list.Append(RLPUint256ToBlobValue(value_));
-  list.Append(base::Value(data_));
+  RLPWriter writer;
+  writer.Reserve(data_.size() + kRLPFieldsReserve);
+  writer.BeginList();
+  writer.AddUint256(nonce_.value());
+  writer.AddUint256(gas_price_);
+  writer.AddUint256(gas_limit_);
+  writer.AddBytes(to_.bytes());
+  writer.AddUint256(value_);
+  writer.AddBytes(data_);
   if (chain_id) {
-    list.Append(RLPUint256ToBlobValue(chain_id));
-    list.Append(RLPUint256ToBlobValue(0));
-    list.Append(RLPUint256ToBlobValue(0));
+    writer.AddUint256(chain_id);
+    writer.AddUint256(0);
+    writer.AddUint256(0);
   }
+  writer.EndList();
 
-  const std::string message = RLPEncode(std::move(list));
-  auto result = std::vector<uint8_t>(message.begin(), message.end());
-  return hash ? KeccakHash(result) : result;
+  return hash ? KeccakHash(writer.output()) : writer.output();
 }
 
 std::string EthTransaction::GetSignedTransaction() const {
   DCHECK(nonce_);
-  base::ListValue list;
-  list.Append(RLPUint256ToBlobValue(nonce_.value()));
-  list.Append(RLPUint256ToBlobValue(gas_price_));
-  list.Append(RLPUint256ToBlobValue(gas_limit_));
-  list.Append(base::Value(to_.bytes()));
-  list.Append(RLPUint256ToBlobValue(value_));
-  list.Append(base::Value(data_));
-  list.Append(RLPUint256ToBlobValue(v_));
-  list.Append(base::Value(r_));
-  list.Append(base::Value(s_));
-
-  return ToHex(RLPEncode(std::move(list)));
+  RLPWriter writer;
+  writer.Reserve(data_.size() + kRLPFieldsReserve);
+  writer.BeginList();
+  writer.AddUint256(nonce_.value());
+  writer.AddUint256(gas_price_);
+  writer.AddUint256(gas_limit_);
+  writer.AddBytes(to_.bytes());
+  writer.AddUint256(value_);
+  writer.AddBytes(data_);
+  writer.AddUint256(v_);
+  writer.AddBytes(r_);
+  writer.AddBytes(s_);
+  writer.EndList();
+
+  return ToHex(writer.output());
 }
 
 bool EthTransaction::ProcessVRS(const std::string& v,
@@ -90,6 +90,10 @@ class EthTransaction {
   virtual uint256_t GetUpfrontCost(uint256_t block_base_fee = 0) const;
 
  protected:
+  // Room for the RLP encoding of the fields other than data and access list,
+  // including the length prefix of the data and the transaction's list header
+  static constexpr size_t kRLPFieldsReserve = 512;
+
   // type 0 would be LegacyTransaction
   uint8_t type_ = 0;
 
@@ -111,7 +111,8 @@ EthTxManager::EthTxManager(TxService* tx_service,
                            JsonRpcService* json_rpc_service,
                            KeyringService* keyring_service,
                            PrefService* prefs)
-    : TxManager(std::make_unique<EthTxStateManager>(prefs, json_rpc_service),
+    : TxManager(mojom::CoinType::ETH,
+                std::make_unique<EthTxStateManager>(prefs, json_rpc_service),
                 std::make_unique<EthBlockTracker>(json_rpc_service),
                 tx_service,
                 json_rpc_service,
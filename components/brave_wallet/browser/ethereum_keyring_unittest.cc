@@ -8,8 +8,10 @@
 #include <memory>
 #include <utility>
 
+#include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/timer/elapsed_timer.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_transaction.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -115,7 +117,7 @@ TEST(EthereumKeyringUnitTest, SignMessage) {
   key->SetPrivateKey(private_key);
 
   EthereumKeyring keyring;
-  keyring.accounts_.push_back(std::move(key));
+  keyring.AddAccount(std::move(key));
   EXPECT_EQ(keyring.GetAddress(0),
             "0xbE93f9BacBcFFC8ee6663f2647917ed7A20a57BB");
 
@@ -260,4 +262,53 @@ TEST(EthereumKeyringUnitTest, GetPublicKeyFromX25519_XSalsa20_Poly1305) {
       "", &public_encryption_key));
 }
 
+// Derives 1,000 accounts and looks each of them up by address, as signing
+// and private key export do, and compares it with recomputing every address
+// for a lookup.
+TEST(EthereumKeyringUnitTest, ManyAccounts) {
+  constexpr size_t kAccountCount = 1000;
+  EthereumKeyring keyring;
+  std::vector<uint8_t> seed;
+  EXPECT_TRUE(base::HexStringToBytes(
+      "13ca6c28d26812f82db27908de0b0b7b18940cc4e9d96ebd7de190f706741489907ef65b"
+      "8f9e36c31dc46e81472b6a5e40a4487e725ace445b8203f243fb8958",
+      &seed));
+  keyring.ConstructRootHDKey(seed, "m/44'/60'/0'/0");
+
+  base::ElapsedTimer derive_timer;
+  keyring.AddAccounts(kAccountCount);
+  const base::TimeDelta derive_time = derive_timer.Elapsed();
+  ASSERT_EQ(keyring.GetAccountsNumber(), kAccountCount);
+  EXPECT_EQ(keyring.GetAddress(0),
+            "0x2166fB4e11D44100112B1124ac593081519cA1ec");
+  EXPECT_EQ(keyring.GetDiscoveryAddress(kAccountCount - 1),
+            keyring.GetAddress(kAccountCount - 1));
+
+  const std::vector<std::string> accounts = keyring.GetAccounts();
+  base::ElapsedTimer lookup_timer;
+  for (size_t i = 0; i < kAccountCount; ++i) {
+    EXPECT_EQ(keyring.GetAccountIndex(accounts[i]), i);
+    EXPECT_TRUE(keyring.GetHDKeyFromAddress(accounts[i]));
+  }
+  const base::TimeDelta lookup_time = lookup_timer.Elapsed();
+
+  // What a lookup of the last account used to cost.
+  HDKeyring* hd_keyring = &keyring;
+  base::ElapsedTimer scan_timer;
+  for (size_t i = 0; i < kAccountCount; ++i) {
+    EXPECT_EQ(hd_keyring->GetAddressInternal(keyring.accounts_[i].get()),
+              accounts[i]);
+  }
+  const base::TimeDelta scan_time = scan_timer.Elapsed();
+
+  VLOG(1) << "Derived " << kAccountCount << " accounts in " << derive_time
+          << ", " << kAccountCount << " lookups took " << lookup_time
+          << ", recomputing every address for one lookup took " << scan_time;
+
+  keyring.RemoveAccount();
+  EXPECT_FALSE(keyring.GetAccountIndex(accounts[kAccountCount - 1]));
+  EXPECT_EQ(keyring.GetAccountIndex(accounts[kAccountCount - 2]),
+            kAccountCount - 2);
+}
+
 }  // namespace brave_wallet
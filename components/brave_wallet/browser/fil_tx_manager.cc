@@ -18,7 +18,8 @@ FilTxManager::FilTxManager(TxService* tx_service,
                            JsonRpcService* json_rpc_service,
                            KeyringService* keyring_service,
                            PrefService* prefs)
-    : TxManager(std::make_unique<FilTxStateManager>(prefs, json_rpc_service),
+    : TxManager(mojom::CoinType::FIL,
+                std::make_unique<FilTxStateManager>(prefs, json_rpc_service),
                 std::make_unique<FilBlockTracker>(json_rpc_service),
                 tx_service,
                 json_rpc_service,
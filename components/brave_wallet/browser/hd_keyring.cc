@@ -24,30 +24,39 @@ void HDKeyring::ConstructRootHDKey(const std::vector<uint8_t>& seed,
 }
 
 void HDKeyring::AddAccounts(size_t number) {
+  if (!root_)
+    return;
   size_t cur_accounts_number = accounts_.size();
+  accounts_.reserve(cur_accounts_number + number);
+  account_addresses_.reserve(cur_accounts_number + number);
   for (size_t i = cur_accounts_number; i < cur_accounts_number + number; ++i) {
-    if (root_) {
-      accounts_.push_back(root_->DeriveChild(i));
-    }
+    AddAccount(DeriveAccount(i));
   }
 }
 
+std::unique_ptr<HDKeyBase> HDKeyring::DeriveAccount(size_t index) const {
+  return root_->DeriveChild(index);
+}
+
+void HDKeyring::AddAccount(std::unique_ptr<HDKeyBase> hd_key) {
+  const std::string address = GetAddressInternal(hd_key.get());
+  // Keep the first index if the same key is added twice
+  if (!address.empty())
+    account_indexes_.emplace(address, accounts_.size());
+  account_addresses_.push_back(address);
+  accounts_.push_back(std::move(hd_key));
+}
+
 std::vector<std::string> HDKeyring::GetAccounts() const {
-  std::vector<std::string> addresses;
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    addresses.push_back(GetAddress(i));
-  }
-  return addresses;
+  return account_addresses_;
 }
 
 absl::optional<size_t> HDKeyring::GetAccountIndex(
     const std::string& address) const {
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    if (GetAddress(i) == address) {
-      return i;
-    }
-  }
-  return absl::nullopt;
+  const auto iter = account_indexes_.find(address);
+  if (iter == account_indexes_.end())
+    return absl::nullopt;
+  return iter->second;
 }
 
 size_t HDKeyring::GetAccountsNumber() const {
@@ -55,6 +64,12 @@ size_t HDKeyring::GetAccountsNumber() const {
 }
 
 void HDKeyring::RemoveAccount() {
+  const auto iter = account_indexes_.find(account_addresses_.back());
+  if (iter != account_indexes_.end() &&
+      iter->second == account_addresses_.size() - 1) {
+    account_indexes_.erase(iter);
+  }
+  account_addresses_.pop_back();
   accounts_.pop_back();
 }
 
@@ -64,10 +79,8 @@ bool HDKeyring::AddImportedAddress(const std::string& address,
   if (imported_accounts_[address])
     return false;
   // Check if it is duplicate in derived accounts
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    if (GetAddress(i) == address)
-      return false;
-  }
+  if (GetAccountIndex(address))
+    return false;
 
   imported_accounts_[address] = std::move(hd_key);
   return true;
@@ -95,13 +108,13 @@ bool HDKeyring::RemoveImportedAccount(const std::string& address) {
 }
 
 std::string HDKeyring::GetAddress(size_t index) const {
-  if (accounts_.empty() || index >= accounts_.size())
+  if (index >= account_addresses_.size())
     return std::string();
-  return GetAddressInternal(accounts_[index].get());
+  return account_addresses_[index];
 }
 
 std::string HDKeyring::GetDiscoveryAddress(size_t index) const {
-  if (auto key = root_->DeriveChild(index)) {
+  if (auto key = DeriveAccount(index)) {
     return GetAddressInternal(key.get());
   }
   return std::string();
@@ -129,11 +142,10 @@ HDKeyBase* HDKeyring::GetHDKeyFromAddress(const std::string& address) {
   const auto imported_accounts_iter = imported_accounts_.find(address);
   if (imported_accounts_iter != imported_accounts_.end())
     return imported_accounts_iter->second.get();
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    if (GetAddress(i) == address)
-      return accounts_[i].get();
-  }
-  return nullptr;
+  const absl::optional<size_t> index = GetAccountIndex(address);
+  if (!index)
+    return nullptr;
+  return accounts_[*index].get();
 }
 
 }  // namespace brave_wallet
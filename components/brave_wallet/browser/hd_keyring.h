@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/containers/flat_map.h"
@@ -31,7 +32,7 @@ class HDKeyring {
   virtual void ConstructRootHDKey(const std::vector<uint8_t>& seed,
                                   const std::string& hd_path);
 
-  virtual void AddAccounts(size_t number);
+  void AddAccounts(size_t number);
   // This will return vector of address of all accounts
   std::vector<std::string> GetAccounts() const;
   absl::optional<size_t> GetAccountIndex(const std::string& address) const;
@@ -56,6 +57,10 @@ class HDKeyring {
  protected:
   // Bitcoin keyring can override this for different address calculation
   virtual std::string GetAddressInternal(HDKeyBase* hd_key) const = 0;
+  // Derives the key of the account at |index| from |root_|
+  virtual std::unique_ptr<HDKeyBase> DeriveAccount(size_t index) const;
+  // Appends a derived account and caches its address
+  void AddAccount(std::unique_ptr<HDKeyBase> hd_key);
   bool AddImportedAddress(const std::string& address,
                           std::unique_ptr<HDKeyBase> hd_key);
   HDKeyBase* GetHDKeyFromAddress(const std::string& address);
@@ -63,12 +68,17 @@ class HDKeyring {
   std::unique_ptr<HDKeyBase> root_;
   std::unique_ptr<HDKeyBase> master_key_;
   std::vector<std::unique_ptr<HDKeyBase>> accounts_;
+  // Addresses of |accounts_|, computed once when they are added
+  std::vector<std::string> account_addresses_;
+  // (address, index in |accounts_|)
+  std::unordered_map<std::string, size_t> account_indexes_;
   // (address, key)
   base::flat_map<std::string, std::unique_ptr<HDKeyBase>> imported_accounts_;
 
  private:
   FRIEND_TEST_ALL_PREFIXES(EthereumKeyringUnitTest, ConstructRootHDKey);
   FRIEND_TEST_ALL_PREFIXES(EthereumKeyringUnitTest, SignMessage);
+  FRIEND_TEST_ALL_PREFIXES(EthereumKeyringUnitTest, ManyAccounts);
   FRIEND_TEST_ALL_PREFIXES(SolanaKeyringUnitTest, ConstructRootHDKey);
 };
 
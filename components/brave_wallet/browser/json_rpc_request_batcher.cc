@@ -0,0 +1,211 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/json_rpc_request_batcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "brave/components/brave_wallet/browser/json_rpc_requests_helper.h"
+#include "net/http/http_status_code.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave_wallet {
+
+namespace {
+
+std::string GetRequestKey(const GURL& network_url,
+                          const std::string& json_payload) {
+  return network_url.spec() + '\n' + json_payload;
+}
+
+absl::optional<base::Value> ParseJson(const std::string& json) {
+  return base::JSONReader::Read(json, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
+                                          base::JSON_PARSE_RFC);
+}
+
+}  // namespace
+
+JsonRpcRequestBatcher::JsonRpcRequestBatcher(SendCallback send_callback)
+    : send_callback_(std::move(send_callback)) {
+  DCHECK(send_callback_);
+}
+
+JsonRpcRequestBatcher::~JsonRpcRequestBatcher() = default;
+
+void JsonRpcRequestBatcher::Request(const GURL& network_url,
+                                    const std::string& json_payload,
+                                    ResultCallback callback) {
+  const std::string key = GetRequestKey(network_url, json_payload);
+  auto it = pending_callbacks_.find(key);
+  if (it != pending_callbacks_.end()) {
+    // The same call is already queued or in flight, share its response.
+    it->second.push_back(std::move(callback));
+    return;
+  }
+  pending_callbacks_[key].push_back(std::move(callback));
+  queued_payloads_[network_url].push_back(json_payload);
+
+  if (flush_scheduled_)
+    return;
+  flush_scheduled_ = true;
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&JsonRpcRequestBatcher::Flush,
+                                weak_ptr_factory_.GetWeakPtr()));
+}
+
+void JsonRpcRequestBatcher::Flush() {
+  flush_scheduled_ = false;
+  base::flat_map<GURL, std::vector<std::string>> queued_payloads;
+  queued_payloads.swap(queued_payloads_);
+
+  for (const auto& entry : queued_payloads) {
+    const GURL& network_url = entry.first;
+    const std::vector<std::string>& payloads = entry.second;
+    if (batch_unsupported_urls_.contains(network_url)) {
+      for (const auto& payload : payloads)
+        SendSingle(network_url, payload);
+      continue;
+    }
+    for (size_t begin = 0; begin < payloads.size(); begin += kMaxBatchSize) {
+      size_t end = std::min(begin + kMaxBatchSize, payloads.size());
+      if (end - begin == 1) {
+        SendSingle(network_url, payloads[begin]);
+        continue;
+      }
+      SendBatch(network_url, std::vector<std::string>(payloads.begin() + begin,
+                                                      payloads.begin() + end));
+    }
+  }
+}
+
+void JsonRpcRequestBatcher::SendSingle(const GURL& network_url,
+                                       const std::string& json_payload) {
+  ++requests_sent_;
+  send_callback_.Run(
+      network_url, json_payload,
+      base::BindOnce(&JsonRpcRequestBatcher::OnSingleResponse,
+                     weak_ptr_factory_.GetWeakPtr(),
+                     GetRequestKey(network_url, json_payload)));
+}
+
+void JsonRpcRequestBatcher::SendBatch(
+    const GURL& network_url,
+    const std::vector<std::string>& json_payloads) {
+  // Every call of a batch needs a distinct id so responses, which may come
+  // back in any order, can be matched. The original ids are restored before
+  // the responses are handed to the callers.
+  base::Value batch(base::Value::Type::LIST);
+  std::vector<base::Value> original_ids;
+  for (size_t i = 0; i < json_payloads.size(); ++i) {
+    absl::optional<base::Value> request = ParseJson(json_payloads[i]);
+    if (!request || !request->is_dict()) {
+      // Left unanswered, so it is sent on its own once the batch returns.
+      NOTREACHED() << "Only single JSON RPC requests can be batched";
+      original_ids.emplace_back();
+      continue;
+    }
+    const base::Value* id = request->FindKey("id");
+    original_ids.push_back(id ? id->Clone() : base::Value());
+    request->SetIntKey("id", static_cast<int>(i));
+    batch.Append(std::move(*request));
+  }
+
+  ++requests_sent_;
+  send_callback_.Run(
+      network_url, GetJSON(batch),
+      base::BindOnce(&JsonRpcRequestBatcher::OnBatchResponse,
+                     weak_ptr_factory_.GetWeakPtr(), network_url, json_payloads,
+                     std::move(original_ids)));
+}
+
+void JsonRpcRequestBatcher::OnSingleResponse(
+    const std::string& key,
+    int http_code,
+    const std::string& response,
+    const base::flat_map<std::string, std::string>& headers) {
+  RunCallbacks(key, http_code, response, headers);
+}
+
+void JsonRpcRequestBatcher::OnBatchResponse(
+    const GURL& network_url,
+    const std::vector<std::string>& json_payloads,
+    std::vector<base::Value> original_ids,
+    int http_code,
+    const std::string& response,
+    const base::flat_map<std::string, std::string>& headers) {
+  DCHECK_EQ(json_payloads.size(), original_ids.size());
+  if ((http_code < 200 || http_code > 299) &&
+      (http_code < 400 || http_code > 599)) {
+    // Not an answer from the endpoint, e.g. a network error.
+    for (const auto& payload : json_payloads)
+      RunCallbacks(GetRequestKey(network_url, payload), http_code, response,
+                   headers);
+    return;
+  }
+
+  if (http_code == net::HTTP_REQUEST_TIMEOUT ||
+      http_code == net::HTTP_TOO_MANY_REQUESTS || http_code >= 500) {
+    // A rate limited or failing endpoint says nothing about batch support,
+    // retry every call on its own this time only.
+    for (const auto& payload : json_payloads)
+      SendSingle(network_url, payload);
+    return;
+  }
+
+  absl::optional<base::Value> responses;
+  if (http_code >= 200 && http_code <= 299)
+    responses = ParseJson(response);
+  if (!responses || !responses->is_list()) {
+    // The endpoint does not understand batches, either rejecting the batch
+    // with a client error or answering with something else than an array.
+    // Retry every call on its own.
+    batch_unsupported_urls_.insert(network_url);
+    for (const auto& payload : json_payloads)
+      SendSingle(network_url, payload);
+    return;
+  }
+
+  std::vector<bool> answered(json_payloads.size(), false);
+  for (auto& item : responses->GetList()) {
+    if (!item.is_dict())
+      continue;
+    absl::optional<int> index = item.FindIntKey("id");
+    if (!index || *index < 0 ||
+        static_cast<size_t>(*index) >= json_payloads.size() ||
+        answered[*index]) {
+      continue;
+    }
+    answered[*index] = true;
+    item.SetKey("id", std::move(original_ids[*index]));
+    RunCallbacks(GetRequestKey(network_url, json_payloads[*index]), http_code,
+                 GetJSON(item), headers);
+  }
+
+  // Some providers silently drop calls from a batch, send those again.
+  for (size_t i = 0; i < json_payloads.size(); ++i) {
+    if (!answered[i])
+      SendSingle(network_url, json_payloads[i]);
+  }
+}
+
+void JsonRpcRequestBatcher::RunCallbacks(
+    const std::string& key,
+    int http_code,
+    const std::string& response,
+    const base::flat_map<std::string, std::string>& headers) {
+  auto it = pending_callbacks_.find(key);
+  if (it == pending_callbacks_.end())
+    return;
+  std::vector<ResultCallback> callbacks = std::move(it->second);
+  pending_callbacks_.erase(it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(http_code, response, headers);
+}
+
+}  // namespace brave_wallet
@@ -0,0 +1,87 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_REQUEST_BATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_REQUEST_BATCHER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
+#include "base/memory/weak_ptr.h"
+#include "base/values.h"
+#include "url/gurl.h"
+
+namespace brave_wallet {
+
+// Collects read-only JSON RPC calls issued within the same task and sends
+// them to each endpoint as a single JSON RPC batch array. Identical calls
+// that are queued or in flight are de-duplicated and share one response.
+// Endpoints which reject a batch with an HTTP client error or answer it with
+// something else than an array are remembered and served with individual
+// requests from then on. Timeouts, rate limiting and server errors only send
+// the calls of that batch individually.
+class JsonRpcRequestBatcher {
+ public:
+  using ResultCallback = base::OnceCallback<void(
+      int http_code,
+      const std::string& response,
+      const base::flat_map<std::string, std::string>& headers)>;
+  using SendCallback =
+      base::RepeatingCallback<void(const GURL& network_url,
+                                   const std::string& json_payload,
+                                   ResultCallback callback)>;
+
+  // Many public providers reject batches above 100 calls.
+  static constexpr size_t kMaxBatchSize = 100;
+
+  explicit JsonRpcRequestBatcher(SendCallback send_callback);
+  ~JsonRpcRequestBatcher();
+  JsonRpcRequestBatcher(const JsonRpcRequestBatcher&) = delete;
+  JsonRpcRequestBatcher& operator=(const JsonRpcRequestBatcher&) = delete;
+
+  // |json_payload| must be a single JSON RPC request object.
+  void Request(const GURL& network_url,
+               const std::string& json_payload,
+               ResultCallback callback);
+
+  size_t requests_sent_for_testing() const { return requests_sent_; }
+
+ private:
+  void Flush();
+  void SendSingle(const GURL& network_url, const std::string& json_payload);
+  void SendBatch(const GURL& network_url,
+                 const std::vector<std::string>& json_payloads);
+  void OnSingleResponse(const std::string& key,
+                        int http_code,
+                        const std::string& response,
+                        const base::flat_map<std::string, std::string>& headers);
+  void OnBatchResponse(const GURL& network_url,
+                       const std::vector<std::string>& json_payloads,
+                       std::vector<base::Value> original_ids,
+                       int http_code,
+                       const std::string& response,
+                       const base::flat_map<std::string, std::string>& headers);
+  void RunCallbacks(const std::string& key,
+                    int http_code,
+                    const std::string& response,
+                    const base::flat_map<std::string, std::string>& headers);
+
+  SendCallback send_callback_;
+  // <network_url + payload, callbacks waiting for the result>
+  base::flat_map<std::string, std::vector<ResultCallback>> pending_callbacks_;
+  // Requests waiting for the next flush, grouped by endpoint.
+  base::flat_map<GURL, std::vector<std::string>> queued_payloads_;
+  base::flat_set<GURL> batch_unsupported_urls_;
+  bool flush_scheduled_ = false;
+  size_t requests_sent_ = 0;
+  base::WeakPtrFactory<JsonRpcRequestBatcher> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_wallet
+
+#endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_REQUEST_BATCHER_H_
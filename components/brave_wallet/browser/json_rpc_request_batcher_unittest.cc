@@ -0,0 +1,291 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/json_rpc_request_batcher.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/time.h"
+#include "brave/components/brave_wallet/browser/eth_data_builder.h"
+#include "brave/components/brave_wallet/browser/eth_requests.h"
+#include "brave/components/brave_wallet/browser/json_rpc_requests_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_wallet {
+
+namespace {
+
+constexpr base::TimeDelta kRoundTripTime = base::Milliseconds(100);
+
+// Answers every call with its own params serialized as the result, which
+// lets callers check that they were handed the response to their call.
+base::Value GetResponseForRequest(const base::Value& request) {
+  base::Value response(base::Value::Type::DICTIONARY);
+  response.SetStringKey("jsonrpc", "2.0");
+  response.SetKey("id", request.FindKey("id")->Clone());
+  response.SetStringKey("result", GetJSON(*request.FindKey("params")));
+  return response;
+}
+
+std::string GetExpectedResponse(const std::string& json_payload) {
+  auto request = base::JSONReader::Read(json_payload);
+  return GetJSON(GetResponseForRequest(*request));
+}
+
+}  // namespace
+
+class JsonRpcRequestBatcherUnitTest : public testing::Test {
+ public:
+  JsonRpcRequestBatcherUnitTest()
+      : network_url_("https://mainnet-infura.brave.com/"),
+        batcher_(base::BindRepeating(&JsonRpcRequestBatcherUnitTest::Send,
+                                     base::Unretained(this))) {}
+  ~JsonRpcRequestBatcherUnitTest() override = default;
+
+ protected:
+  // Mock endpoint, every request is answered after |kRoundTripTime|.
+  void Send(const GURL& network_url,
+            const std::string& json_payload,
+            JsonRpcRequestBatcher::ResultCallback callback) {
+    EXPECT_EQ(network_url, network_url_);
+    sent_payloads_.push_back(json_payload);
+
+    int http_code = 200;
+    std::string response;
+    auto request = base::JSONReader::Read(json_payload);
+    ASSERT_TRUE(request);
+    if (http_error_) {
+      http_code = 500;
+    } else if (request->is_list() && batch_http_error_) {
+      http_code = batch_http_error_;
+    } else if (request->is_list() && !supports_batch_) {
+      response = R"({"jsonrpc":"2.0","id":null,"error":{"code":-32600,
+          "message":"Invalid request"}})";
+    } else if (request->is_list()) {
+      base::Value responses(base::Value::Type::LIST);
+      // Answer in reverse order, the spec allows any order.
+      auto& list = request->GetList();
+      for (auto it = list.rbegin(); it != list.rend(); ++it) {
+        if (drop_batch_items_ && it == list.rbegin())
+          continue;
+        responses.Append(GetResponseForRequest(*it));
+      }
+      response = GetJSON(responses);
+    } else {
+      response = GetJSON(GetResponseForRequest(*request));
+    }
+
+    base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
+        FROM_HERE,
+        base::BindOnce(std::move(callback), http_code, response,
+                       base::flat_map<std::string, std::string>()),
+        kRoundTripTime);
+  }
+
+  // Issues |json_payload| and records the response it receives.
+  void Request(const std::string& json_payload) {
+    batcher_.Request(network_url_, json_payload,
+                     base::BindLambdaForTesting(
+                         [&, json_payload](
+                             int http_code, const std::string& response,
+                             const base::flat_map<std::string, std::string>&) {
+                           responses_.emplace_back(json_payload, response);
+                           http_codes_.push_back(http_code);
+                         }));
+  }
+
+  void ExpectResponsesMatchRequests() {
+    for (const auto& entry : responses_)
+      EXPECT_EQ(entry.second, GetExpectedResponse(entry.first));
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  GURL network_url_;
+  JsonRpcRequestBatcher batcher_;
+  std::vector<std::string> sent_payloads_;
+  // <request payload, response>
+  std::vector<std::pair<std::string, std::string>> responses_;
+  std::vector<int> http_codes_;
+  bool supports_batch_ = true;
+  bool drop_batch_items_ = false;
+  bool http_error_ = false;
+  // HTTP status answered to batches, 0 for none.
+  int batch_http_error_ = 0;
+};
+
+TEST_F(JsonRpcRequestBatcherUnitTest, SingleRequestIsSentAsIs) {
+  const std::string payload = eth::eth_getBalance("0x1", "latest");
+  Request(payload);
+  task_environment_.RunUntilIdle();
+  ASSERT_EQ(sent_payloads_.size(), 1u);
+  EXPECT_EQ(sent_payloads_[0], payload);
+
+  task_environment_.FastForwardBy(kRoundTripTime);
+  ASSERT_EQ(responses_.size(), 1u);
+  ExpectResponsesMatchRequests();
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, BatchesRequestsOfSameTask) {
+  Request(eth::eth_getBalance("0x1", "latest"));
+  Request(eth::eth_getBalance("0x2", "latest"));
+  Request(eth::eth_getTransactionCount("0x1", "latest"));
+  task_environment_.RunUntilIdle();
+  ASSERT_EQ(sent_payloads_.size(), 1u);
+  auto batch = base::JSONReader::Read(sent_payloads_[0]);
+  ASSERT_TRUE(batch && batch->is_list());
+  ASSERT_EQ(batch->GetList().size(), 3u);
+  for (size_t i = 0; i < 3; ++i)
+    EXPECT_EQ(*batch->GetList()[i].FindIntKey("id"), static_cast<int>(i));
+
+  task_environment_.FastForwardBy(kRoundTripTime);
+  ASSERT_EQ(responses_.size(), 3u);
+  ExpectResponsesMatchRequests();
+  EXPECT_EQ(batcher_.requests_sent_for_testing(), 1u);
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, DeduplicatesIdenticalRequests) {
+  const std::string payload = eth::eth_getBalance("0x1", "latest");
+  Request(payload);
+  Request(payload);
+  task_environment_.RunUntilIdle();
+  // Also shared while the first one is in flight.
+  Request(payload);
+  task_environment_.FastForwardBy(kRoundTripTime);
+
+  ASSERT_EQ(sent_payloads_.size(), 1u);
+  EXPECT_EQ(sent_payloads_[0], payload);
+  ASSERT_EQ(responses_.size(), 3u);
+  ExpectResponsesMatchRequests();
+
+  // Once answered the request is sent again.
+  Request(payload);
+  task_environment_.FastForwardBy(kRoundTripTime);
+  EXPECT_EQ(sent_payloads_.size(), 2u);
+  EXPECT_EQ(responses_.size(), 4u);
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, FallsBackWhenBatchNotSupported) {
+  supports_batch_ = false;
+  Request(eth::eth_getBalance("0x1", "latest"));
+  Request(eth::eth_getBalance("0x2", "latest"));
+  task_environment_.FastForwardBy(2 * kRoundTripTime);
+  // One rejected batch, then one request per call.
+  EXPECT_EQ(sent_payloads_.size(), 3u);
+  ASSERT_EQ(responses_.size(), 2u);
+  ExpectResponsesMatchRequests();
+
+  // The endpoint is not offered batches anymore.
+  Request(eth::eth_getBalance("0x3", "latest"));
+  Request(eth::eth_getBalance("0x4", "latest"));
+  task_environment_.FastForwardBy(kRoundTripTime);
+  EXPECT_EQ(sent_payloads_.size(), 5u);
+  ASSERT_EQ(responses_.size(), 4u);
+  ExpectResponsesMatchRequests();
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, ResendsCallsMissingFromBatch) {
+  drop_batch_items_ = true;
+  Request(eth::eth_getBalance("0x1", "latest"));
+  Request(eth::eth_getBalance("0x2", "latest"));
+  task_environment_.FastForwardBy(2 * kRoundTripTime);
+  EXPECT_EQ(sent_payloads_.size(), 2u);
+  ASSERT_EQ(responses_.size(), 2u);
+  ExpectResponsesMatchRequests();
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, FallsBackWhenBatchGetsHttpError) {
+  batch_http_error_ = 413;
+  Request(eth::eth_getBalance("0x1", "latest"));
+  Request(eth::eth_getBalance("0x2", "latest"));
+  task_environment_.FastForwardBy(2 * kRoundTripTime);
+  // One rejected batch, then one request per call.
+  EXPECT_EQ(sent_payloads_.size(), 3u);
+  EXPECT_EQ(http_codes_, std::vector<int>({200, 200}));
+  ASSERT_EQ(responses_.size(), 2u);
+  ExpectResponsesMatchRequests();
+
+  // The endpoint is not offered batches anymore.
+  Request(eth::eth_getBalance("0x3", "latest"));
+  Request(eth::eth_getBalance("0x4", "latest"));
+  task_environment_.FastForwardBy(kRoundTripTime);
+  EXPECT_EQ(sent_payloads_.size(), 5u);
+  ASSERT_EQ(responses_.size(), 4u);
+  ExpectResponsesMatchRequests();
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, KeepsBatchingAfterServerError) {
+  batch_http_error_ = 503;
+  Request(eth::eth_getBalance("0x1", "latest"));
+  Request(eth::eth_getBalance("0x2", "latest"));
+  task_environment_.FastForwardBy(2 * kRoundTripTime);
+  // The failed batch is retried call by call.
+  EXPECT_EQ(sent_payloads_.size(), 3u);
+  EXPECT_EQ(http_codes_, std::vector<int>({200, 200}));
+  ASSERT_EQ(responses_.size(), 2u);
+  ExpectResponsesMatchRequests();
+
+  // Once the endpoint recovers it gets batches again.
+  batch_http_error_ = 0;
+  Request(eth::eth_getBalance("0x3", "latest"));
+  Request(eth::eth_getBalance("0x4", "latest"));
+  task_environment_.FastForwardBy(kRoundTripTime);
+  ASSERT_EQ(sent_payloads_.size(), 4u);
+  auto batch = base::JSONReader::Read(sent_payloads_[3]);
+  ASSERT_TRUE(batch && batch->is_list());
+  ASSERT_EQ(responses_.size(), 4u);
+  ExpectResponsesMatchRequests();
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, HttpErrorIsReportedToEveryCall) {
+  http_error_ = true;
+  Request(eth::eth_getBalance("0x1", "latest"));
+  Request(eth::eth_getBalance("0x2", "latest"));
+  task_environment_.FastForwardBy(2 * kRoundTripTime);
+  // The batch is retried call by call, each of which fails as well.
+  EXPECT_EQ(sent_payloads_.size(), 3u);
+  EXPECT_EQ(http_codes_, std::vector<int>({500, 500}));
+}
+
+// Portfolio refresh of 50 ERC20 assets for 5 accounts, with the wallet UI
+// asking for every balance twice as it does when panel and page are open.
+TEST_F(JsonRpcRequestBatcherUnitTest, PortfolioRefresh) {
+  constexpr size_t kAssets = 50;
+  constexpr size_t kAccounts = 5;
+  const base::TimeTicks start = base::TimeTicks::Now();
+  for (int pass = 0; pass < 2; ++pass) {
+    for (size_t account = 0; account < kAccounts; ++account) {
+      const std::string address = base::StringPrintf("0x%040zx", account + 1);
+      Request(eth::eth_getBalance(address, "latest"));
+      for (size_t asset = 0; asset < kAssets; ++asset) {
+        std::string data;
+        ASSERT_TRUE(erc20::BalanceOf(address, &data));
+        Request(eth::eth_call("", base::StringPrintf("0x%040zx", asset + 100),
+                              "", "", "", data, "latest"));
+      }
+    }
+  }
+  task_environment_.RunUntilIdle();
+  // 255 distinct calls split into batches of at most kMaxBatchSize.
+  EXPECT_EQ(sent_payloads_.size(), 3u);
+
+  task_environment_.FastForwardBy(kRoundTripTime);
+  ASSERT_EQ(responses_.size(), 2 * kAccounts * (kAssets + 1));
+  ExpectResponsesMatchRequests();
+  // Every call is answered within a single round trip, without batching
+  // 255 requests would compete for the 6 connections allowed per host.
+  EXPECT_EQ(base::TimeTicks::Now() - start, kRoundTripTime);
+}
+
+}  // namespace brave_wallet
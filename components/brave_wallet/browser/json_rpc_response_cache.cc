@@ -0,0 +1,98 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/json_rpc_response_cache.h"
+
+#include "base/logging.h"
+
+namespace brave_wallet {
+
+namespace {
+
+// Bounds memory if a chain stays on the same block for a long time.
+constexpr size_t kMaxResponsesPerBlock = 1000;
+
+}  // namespace
+
+JsonRpcResponseCache::JsonRpcResponseCache(base::TimeDelta max_block_age)
+    : max_block_age_(max_block_age) {}
+
+JsonRpcResponseCache::~JsonRpcResponseCache() = default;
+
+const std::string* JsonRpcResponseCache::Get(const GURL& network_url,
+                                             const std::string& json_payload) {
+  last_read_times_[network_url] = base::TimeTicks::Now();
+  auto block_it = blocks_.find(network_url);
+  if (block_it != blocks_.end() && IsFresh(block_it->second)) {
+    auto it = block_it->second.responses.find(json_payload);
+    if (it != block_it->second.responses.end()) {
+      ++hit_count_;
+      return &it->second;
+    }
+  }
+  ++miss_count_;
+  return nullptr;
+}
+
+std::string JsonRpcResponseCache::GetLatestBlock(
+    const GURL& network_url) const {
+  auto block_it = blocks_.find(network_url);
+  if (block_it == blocks_.end() || !IsFresh(block_it->second))
+    return std::string();
+  return block_it->second.block;
+}
+
+base::TimeTicks JsonRpcResponseCache::GetLastReadTime(
+    const GURL& network_url) const {
+  auto it = last_read_times_.find(network_url);
+  return it == last_read_times_.end() ? base::TimeTicks() : it->second;
+}
+
+void JsonRpcResponseCache::Put(const GURL& network_url,
+                               const std::string& block,
+                               const std::string& json_payload,
+                               const std::string& response) {
+  auto block_it = blocks_.find(network_url);
+  if (block.empty() || block_it == blocks_.end() ||
+      !IsFresh(block_it->second) || block_it->second.block != block) {
+    return;
+  }
+  auto& responses = block_it->second.responses;
+  if (responses.size() >= kMaxResponsesPerBlock &&
+      !responses.contains(json_payload)) {
+    return;
+  }
+  responses[json_payload] = response;
+}
+
+void JsonRpcResponseCache::OnLatestBlock(const GURL& network_url,
+                                         const std::string& block) {
+  BlockInfo& info = blocks_[network_url];
+  if (info.block != block) {
+    VLOG(2) << "New block " << block << " for " << network_url
+            << ", dropping " << info.responses.size()
+            << " cached responses, hits: " << hit_count_
+            << ", misses: " << miss_count_;
+    info.block = block;
+    info.responses.clear();
+  }
+  info.observed_time = base::TimeTicks::Now();
+}
+
+void JsonRpcResponseCache::Invalidate(const GURL& network_url) {
+  blocks_.erase(network_url);
+}
+
+void JsonRpcResponseCache::Clear() {
+  blocks_.clear();
+  last_read_times_.clear();
+}
+
+bool JsonRpcResponseCache::IsFresh(const BlockInfo& info) const {
+  return !info.block.empty() &&
+         base::TimeTicks::Now() - info.observed_time < max_block_age_;
+}
+
+}  // namespace brave_wallet
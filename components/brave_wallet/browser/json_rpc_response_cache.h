@@ -0,0 +1,77 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_RESPONSE_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_RESPONSE_CACHE_H_
+
+#include <string>
+
+#include "base/containers/flat_map.h"
+#include "base/time/time.h"
+#include "url/gurl.h"
+
+namespace brave_wallet {
+
+// Read-through cache for JSON RPC reads whose result only changes when a new
+// block is produced, e.g. balances, allowances and eth_call results.
+//
+// Entries are keyed by endpoint and request payload (which holds the method
+// and params) and tagged with the latest block observed for that endpoint:
+// the block number for EVM chains and the latest blockhash for Solana.
+// Nothing is served once a newer block is observed, or once the observation
+// is older than |max_block_age|: block trackers only poll while there are
+// transactions to track or recent reads of their network.
+class JsonRpcResponseCache {
+ public:
+  explicit JsonRpcResponseCache(base::TimeDelta max_block_age);
+  ~JsonRpcResponseCache();
+  JsonRpcResponseCache(const JsonRpcResponseCache&) = delete;
+  JsonRpcResponseCache& operator=(const JsonRpcResponseCache&) = delete;
+
+  // Returns the cached response or nullptr on a miss.
+  const std::string* Get(const GURL& network_url,
+                         const std::string& json_payload);
+  // Returns the latest block observed for |network_url|, or an empty string
+  // when there is no recent observation.
+  std::string GetLatestBlock(const GURL& network_url) const;
+  // Returns when |network_url| was last read through Get, or a null time.
+  base::TimeTicks GetLastReadTime(const GURL& network_url) const;
+  // Stores |response| if |block|, the block observed when the request was
+  // sent, is still the latest one for |network_url|.
+  void Put(const GURL& network_url,
+           const std::string& block,
+           const std::string& json_payload,
+           const std::string& response);
+
+  // Called whenever the latest block of |network_url| is polled.
+  void OnLatestBlock(const GURL& network_url, const std::string& block);
+  // Drops everything cached for |network_url|, used on chain switch and
+  // when we submit a transaction ourselves.
+  void Invalidate(const GURL& network_url);
+  void Clear();
+
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+
+ private:
+  struct BlockInfo {
+    std::string block;
+    base::TimeTicks observed_time;
+    // <json_payload, response>
+    base::flat_map<std::string, std::string> responses;
+  };
+
+  bool IsFresh(const BlockInfo& info) const;
+
+  const base::TimeDelta max_block_age_;
+  base::flat_map<GURL, BlockInfo> blocks_;
+  base::flat_map<GURL, base::TimeTicks> last_read_times_;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+};
+
+}  // namespace brave_wallet
+
+#endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_RESPONSE_CACHE_H_
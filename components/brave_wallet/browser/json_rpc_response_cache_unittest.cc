@@ -0,0 +1,108 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/json_rpc_response_cache.h"
+
+#include <string>
+
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_wallet {
+
+namespace {
+
+constexpr base::TimeDelta kMaxBlockAge = base::Seconds(20);
+constexpr char kPayload[] =
+    R"({"id":1,"jsonrpc":"2.0","method":"eth_getBalance","params":["0x1","latest"]})";
+constexpr char kResponse[] = R"({"id":1,"jsonrpc":"2.0","result":"0x10"})";
+
+}  // namespace
+
+class JsonRpcResponseCacheUnitTest : public testing::Test {
+ public:
+  JsonRpcResponseCacheUnitTest()
+      : mainnet_url_("https://mainnet-infura.brave.com/"),
+        goerli_url_("https://goerli-infura.brave.com/"),
+        cache_(kMaxBlockAge) {}
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  GURL mainnet_url_;
+  GURL goerli_url_;
+  JsonRpcResponseCache cache_;
+};
+
+TEST_F(JsonRpcResponseCacheUnitTest, NothingCachedWithoutBlock) {
+  EXPECT_EQ(cache_.GetLatestBlock(mainnet_url_), "");
+  cache_.Put(mainnet_url_, "", kPayload, kResponse);
+  EXPECT_FALSE(cache_.Get(mainnet_url_, kPayload));
+  EXPECT_EQ(cache_.hit_count(), 0u);
+  EXPECT_EQ(cache_.miss_count(), 1u);
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, HitUntilNewBlock) {
+  cache_.OnLatestBlock(mainnet_url_, "0x1");
+  cache_.Put(mainnet_url_, cache_.GetLatestBlock(mainnet_url_), kPayload,
+             kResponse);
+  const std::string* response = cache_.Get(mainnet_url_, kPayload);
+  ASSERT_TRUE(response);
+  EXPECT_EQ(*response, kResponse);
+  // Same block polled again keeps the entries.
+  cache_.OnLatestBlock(mainnet_url_, "0x1");
+  EXPECT_TRUE(cache_.Get(mainnet_url_, kPayload));
+  // Entries are per chain.
+  EXPECT_FALSE(cache_.Get(goerli_url_, kPayload));
+
+  cache_.OnLatestBlock(mainnet_url_, "0x2");
+  EXPECT_FALSE(cache_.Get(mainnet_url_, kPayload));
+  EXPECT_EQ(cache_.hit_count(), 2u);
+  EXPECT_EQ(cache_.miss_count(), 2u);
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, ResponseFromPreviousBlockIsNotStored) {
+  cache_.OnLatestBlock(mainnet_url_, "0x1");
+  const std::string block = cache_.GetLatestBlock(mainnet_url_);
+  // A new block arrives while the request is in flight.
+  cache_.OnLatestBlock(mainnet_url_, "0x2");
+  cache_.Put(mainnet_url_, block, kPayload, kResponse);
+  EXPECT_FALSE(cache_.Get(mainnet_url_, kPayload));
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, ExpiresWhenBlockIsNotPolled) {
+  cache_.OnLatestBlock(mainnet_url_, "0x1");
+  cache_.Put(mainnet_url_, "0x1", kPayload, kResponse);
+  task_environment_.FastForwardBy(kMaxBlockAge - base::Seconds(1));
+  EXPECT_TRUE(cache_.Get(mainnet_url_, kPayload));
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_FALSE(cache_.Get(mainnet_url_, kPayload));
+  EXPECT_EQ(cache_.GetLatestBlock(mainnet_url_), "");
+
+  // Polling again without a new block makes the entries fresh again.
+  cache_.OnLatestBlock(mainnet_url_, "0x1");
+  EXPECT_TRUE(cache_.Get(mainnet_url_, kPayload));
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, Invalidate) {
+  cache_.OnLatestBlock(mainnet_url_, "0x1");
+  cache_.OnLatestBlock(goerli_url_, "0x5");
+  cache_.Put(mainnet_url_, "0x1", kPayload, kResponse);
+  cache_.Put(goerli_url_, "0x5", kPayload, kResponse);
+
+  cache_.Invalidate(mainnet_url_);
+  EXPECT_FALSE(cache_.Get(mainnet_url_, kPayload));
+  EXPECT_TRUE(cache_.Get(goerli_url_, kPayload));
+  // Nothing is stored until the next block is observed.
+  cache_.Put(mainnet_url_, "0x1", kPayload, kResponse);
+  EXPECT_FALSE(cache_.Get(mainnet_url_, kPayload));
+
+  cache_.Clear();
+  EXPECT_FALSE(cache_.Get(goerli_url_, kPayload));
+}
+
+}  // namespace brave_wallet
@@ -9,10 +9,14 @@
 
 #include "base/base64.h"
 #include "base/bind.h"
+#include "base/containers/flat_set.h"
 #include "base/environment.h"
+#include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/no_destructor.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/common/brave_services_key.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
@@ -35,6 +39,7 @@
 #include "components/grit/brave_components_strings.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
+#include "net/http/http_status_code.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "third_party/re2/src/re2/re2.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -42,6 +47,9 @@
 
 namespace {
 
+// How long after the last cached read of a network its head is still polled.
+constexpr base::TimeDelta kCachedReadsTimeout = base::Minutes(1);
+
 // The domain name should be a-z | A-Z | 0-9 and hyphen(-).
 // The domain name should not start or end with hyphen (-).
 // The domain name can be a subdomain.
@@ -96,6 +104,23 @@ bool IsChainExist(PrefService* prefs, const std::string& chain_id) {
   return false;
 }
 
+// Returns the distinct methods of a JSON RPC batch joined with commas, or an
+// empty string if |json_payload| is not a batch.
+std::string GetBatchMethods(const std::string& json_payload) {
+  absl::optional<base::Value> batch = base::JSONReader::Read(json_payload);
+  if (!batch || !batch->is_list())
+    return std::string();
+  base::flat_set<std::string> methods;
+  for (const auto& request : batch->GetList()) {
+    const std::string* method =
+        request.is_dict() ? request.FindStringKey("method") : nullptr;
+    if (method)
+      methods.insert(*method);
+  }
+  return base::JoinString(
+      std::vector<std::string>(methods.begin(), methods.end()), ",");
+}
+
 }  // namespace
 
 namespace brave_wallet {
@@ -106,6 +131,10 @@ JsonRpcService::JsonRpcService(
     : api_request_helper_(new api_request_helper::APIRequestHelper(
           GetNetworkTrafficAnnotationTag(),
           url_loader_factory)),
+      request_batcher_(std::make_unique<JsonRpcRequestBatcher>(
+          base::BindRepeating(&JsonRpcService::SendBatchableRequest,
+                              base::Unretained(this)))),
+      response_cache_(base::Seconds(kBlockTrackerDefaultTimeInSeconds)),
       prefs_(prefs),
       weak_ptr_factory_(this) {
   if (!SetNetwork(GetCurrentChainId(prefs_, mojom::CoinType::ETH),
@@ -211,6 +240,11 @@ void JsonRpcService::RequestInternal(const std::string& json_payload,
     } else if (method == kEthBlockNumber) {
       request_headers["X-Eth-Block"] = "true";
     }
+  } else {
+    // Batches sent by |request_batcher_| list the methods they hold.
+    method = GetBatchMethods(json_payload);
+    if (!method.empty())
+      request_headers["X-Eth-Method"] = method;
   }
 
   std::unique_ptr<base::Environment> env(base::Environment::Create());
@@ -225,6 +259,69 @@ void JsonRpcService::RequestInternal(const std::string& json_payload,
                                std::move(callback), request_headers);
 }
 
+void JsonRpcService::SendBatchableRequest(
+    const GURL& network_url,
+    const std::string& json_payload,
+    RequestIntermediateCallback callback) {
+  RequestInternal(json_payload, true, network_url, std::move(callback));
+}
+
+void JsonRpcService::RequestCachedRead(const GURL& network_url,
+                                       const std::string& json_payload,
+                                       RequestIntermediateCallback callback) {
+  const std::string* cached_response =
+      response_cache_.Get(network_url, json_payload);
+  if (cached_response) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(std::move(callback), net::HTTP_OK, *cached_response,
+                       base::flat_map<std::string, std::string>()));
+    return;
+  }
+  const std::string block = response_cache_.GetLatestBlock(network_url);
+  if (block.empty()) {
+    for (const auto& network : network_urls_) {
+      if (network.second == network_url)
+        cached_read_without_block_callbacks_.Notify(network.first);
+    }
+  }
+  request_batcher_->Request(
+      network_url, json_payload,
+      base::BindOnce(&JsonRpcService::OnCachedReadResult,
+                     weak_ptr_factory_.GetWeakPtr(), network_url, block,
+                     json_payload, std::move(callback)));
+}
+
+bool JsonRpcService::HasRecentCachedReads(mojom::CoinType coin) const {
+  auto it = network_urls_.find(coin);
+  if (it == network_urls_.end())
+    return false;
+  const base::TimeTicks last_read_time =
+      response_cache_.GetLastReadTime(it->second);
+  return !last_read_time.is_null() &&
+         base::TimeTicks::Now() - last_read_time < kCachedReadsTimeout;
+}
+
+base::CallbackListSubscription
+JsonRpcService::AddCachedReadWithoutBlockCallback(
+    CachedReadWithoutBlockCallback callback) {
+  return cached_read_without_block_callbacks_.Add(std::move(callback));
+}
+
+void JsonRpcService::OnCachedReadResult(
+    const GURL& network_url,
+    const std::string& block,
+    const std::string& json_payload,
+    RequestIntermediateCallback callback,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  base::Value result;
+  if (status >= 200 && status <= 299 && ParseResult(body, &result))
+    response_cache_.Put(network_url, block, json_payload, body);
+  std::move(callback).Run(status, body, headers);
+}
+
 void JsonRpcService::FirePendingRequestCompleted(const std::string& chain_id,
                                                  const std::string& error) {
   for (const auto& observer : observers_) {
@@ -381,6 +478,9 @@ bool JsonRpcService::SetNetwork(const std::string& chain_id,
     return false;
   }
 
+  // The previous chain is not tracked anymore, so its cached responses
+  // could outlive their block.
+  response_cache_.Invalidate(network_urls_[coin]);
   chain_ids_[coin] = chain_id;
   network_urls_[coin] = network_url;
   DictionaryPrefUpdate update(prefs_, kBraveWalletSelectedNetworks);
@@ -513,15 +613,16 @@ void JsonRpcService::SetCustomNetworkForTesting(const std::string& chain_id,
 }
 
 void JsonRpcService::GetBlockNumber(GetBlockNumberCallback callback) {
-  auto internal_callback =
-      base::BindOnce(&JsonRpcService::OnGetBlockNumber,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_blockNumber(), true,
-                  network_urls_[mojom::CoinType::ETH],
+  const GURL& network_url = network_urls_[mojom::CoinType::ETH];
+  auto internal_callback = base::BindOnce(
+      &JsonRpcService::OnGetBlockNumber, weak_ptr_factory_.GetWeakPtr(),
+      network_url, std::move(callback));
+  RequestInternal(eth::eth_blockNumber(), true, network_url,
                   std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetBlockNumber(
+    const GURL& network_url,
     GetBlockNumberCallback callback,
     const int status,
     const std::string& body,
@@ -541,6 +642,7 @@ void JsonRpcService::OnGetBlockNumber(
     return;
   }
 
+  response_cache_.OnLatestBlock(network_url, Uint256ValueToHex(block_number));
   std::move(callback).Run(block_number, mojom::ProviderError::kSuccess, "");
 }
 
@@ -602,8 +704,8 @@ void JsonRpcService::GetBalance(const std::string& address,
     auto internal_callback =
         base::BindOnce(&JsonRpcService::OnEthGetBalance,
                        weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-    RequestInternal(eth::eth_getBalance(address, "latest"), true, network_url,
-                    std::move(internal_callback));
+    RequestCachedRead(network_url, eth::eth_getBalance(address, "latest"),
+                      std::move(internal_callback));
     return;
   } else if (coin == mojom::CoinType::FIL) {
     auto internal_callback =
@@ -611,9 +713,11 @@ void JsonRpcService::GetBalance(const std::string& address,
                        weak_ptr_factory_.GetWeakPtr(), std::move(callback));
     // TODO(spyloggsster): Make sure network url is available when known
     // Filcoin networks are added.
-    RequestInternal(fil::getBalance(address), true,
-                    network_urls_[mojom::CoinType::FIL],
-                    std::move(internal_callback));
+    // Filecoin has no block tracker feeding |response_cache_| yet, so its
+    // reads are not cached.
+    request_batcher_->Request(network_urls_[mojom::CoinType::FIL],
+                              fil::getBalance(address),
+                              std::move(internal_callback));
     return;
   }
   std::move(callback).Run("", mojom::ProviderError::kInternalError,
@@ -679,8 +783,8 @@ void JsonRpcService::GetFilTransactionCount(const std::string& address,
       base::BindOnce(&JsonRpcService::OnFilGetTransactionCount,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
 
-  RequestInternal(fil::getTransactionCount(address), true, network_url,
-                  std::move(internal_callback));
+  request_batcher_->Request(network_url, fil::getTransactionCount(address),
+                            std::move(internal_callback));
 }
 
 void JsonRpcService::GetEthTransactionCount(const std::string& address,
@@ -696,8 +800,9 @@ void JsonRpcService::GetEthTransactionCount(const std::string& address,
       base::BindOnce(&JsonRpcService::OnEthGetTransactionCount,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
 
-  RequestInternal(eth::eth_getTransactionCount(address, "latest"), true,
-                  network_url, std::move(internal_callback));
+  RequestCachedRead(network_url,
+                    eth::eth_getTransactionCount(address, "latest"),
+                    std::move(internal_callback));
 }
 
 void JsonRpcService::OnFilGetTransactionCount(
@@ -796,6 +901,8 @@ void JsonRpcService::OnSendRawTransaction(
     const int status,
     const std::string& body,
     const base::flat_map<std::string, std::string>& headers) {
+  // Balances and nonces of our own accounts are about to change.
+  response_cache_.Invalidate(network_urls_[mojom::CoinType::ETH]);
   if (status < 200 || status > 299) {
     std::move(callback).Run(
         "", mojom::ProviderError::kInternalError,
@@ -831,8 +938,9 @@ void JsonRpcService::GetERC20TokenBalance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC20TokenBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_call("", contract, "", "", "", data, "latest"), true,
-                  network_url, std::move(internal_callback));
+  RequestCachedRead(
+      network_url, eth::eth_call("", contract, "", "", "", data, "latest"),
+      std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC20TokenBalance(
@@ -873,9 +981,10 @@ void JsonRpcService::GetERC20TokenAllowance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC20TokenAllowance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(
-      eth::eth_call("", contract_address, "", "", "", data, "latest"), true,
-      network_urls_[mojom::CoinType::ETH], std::move(internal_callback));
+  RequestCachedRead(
+      network_urls_[mojom::CoinType::ETH],
+      eth::eth_call("", contract_address, "", "", "", data, "latest"),
+      std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC20TokenAllowance(
@@ -1378,8 +1487,9 @@ void JsonRpcService::GetERC721OwnerOf(const std::string& contract,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC721OwnerOf,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_call("", contract, "", "", "", data, "latest"), true,
-                  network_url, std::move(internal_callback));
+  RequestCachedRead(
+      network_url, eth::eth_call("", contract, "", "", "", data, "latest"),
+      std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC721OwnerOf(
@@ -1603,6 +1713,7 @@ void JsonRpcService::Reset() {
   }
   switch_chain_callbacks_.clear();
   switch_chain_ids_.clear();
+  response_cache_.Clear();
 }
 
 void JsonRpcService::GetSolanaBalance(const std::string& pubkey,
@@ -1619,8 +1730,8 @@ void JsonRpcService::GetSolanaBalance(const std::string& pubkey,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetSolanaBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(solana::getBalance(pubkey), true, network_url,
-                  std::move(internal_callback));
+  RequestCachedRead(network_url, solana::getBalance(pubkey),
+                    std::move(internal_callback));
 }
 
 void JsonRpcService::GetSPLTokenAccountBalance(
@@ -1649,8 +1760,9 @@ void JsonRpcService::GetSPLTokenAccountBalance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetSPLTokenAccountBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(solana::getTokenAccountBalance(*associated_token_account),
-                  true, network_url, std::move(internal_callback));
+  RequestCachedRead(
+      network_url, solana::getTokenAccountBalance(*associated_token_account),
+      std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetSolanaBalance(
@@ -1727,6 +1839,7 @@ void JsonRpcService::OnSendSolanaTransaction(
     const int status,
     const std::string& body,
     const base::flat_map<std::string, std::string>& headers) {
+  response_cache_.Invalidate(network_urls_[mojom::CoinType::SOL]);
   if (status < 200 || status > 299) {
     std::move(callback).Run(
         "", mojom::SolanaProviderError::kInternalError,
@@ -1749,15 +1862,16 @@ void JsonRpcService::OnSendSolanaTransaction(
 
 void JsonRpcService::GetSolanaLatestBlockhash(
     GetSolanaLatestBlockhashCallback callback) {
-  auto internal_callback =
-      base::BindOnce(&JsonRpcService::OnGetSolanaLatestBlockhash,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(solana::getLatestBlockhash(), true,
-                  network_urls_[mojom::CoinType::SOL],
+  const GURL& network_url = network_urls_[mojom::CoinType::SOL];
+  auto internal_callback = base::BindOnce(
+      &JsonRpcService::OnGetSolanaLatestBlockhash,
+      weak_ptr_factory_.GetWeakPtr(), network_url, std::move(callback));
+  RequestInternal(solana::getLatestBlockhash(), true, network_url,
                   std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetSolanaLatestBlockhash(
+    const GURL& network_url,
     GetSolanaLatestBlockhashCallback callback,
     const int status,
     const std::string& body,
@@ -1778,6 +1892,7 @@ void JsonRpcService::OnGetSolanaLatestBlockhash(
     return;
   }
 
+  response_cache_.OnLatestBlock(network_url, blockhash);
   std::move(callback).Run(blockhash, mojom::SolanaProviderError::kSuccess, "");
 }
 
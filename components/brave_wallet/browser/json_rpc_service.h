@@ -13,11 +13,14 @@
 #include <vector>
 
 #include "base/callback.h"
+#include "base/callback_list.h"
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_threadsafe.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
+#include "brave/components/brave_wallet/browser/json_rpc_request_batcher.h"
+#include "brave/components/brave_wallet/browser/json_rpc_response_cache.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
 #include "components/keyed_service/core/keyed_service.h"
@@ -188,6 +191,17 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
 
   GURL GetBlockTrackerUrlFromNetwork(std::string chain_id);
 
+  // Whether the response cache of |coin|'s selected network was read
+  // recently. Block trackers keep polling the chain head while it is, so the
+  // cached reads are checked against a recent block.
+  bool HasRecentCachedReads(mojom::CoinType coin) const;
+  // |callback| runs when a cached read of a coin's selected network finds no
+  // recent block, e.g. because its block tracker is stopped.
+  using CachedReadWithoutBlockCallback =
+      base::RepeatingCallback<void(mojom::CoinType coin)>;
+  base::CallbackListSubscription AddCachedReadWithoutBlockCallback(
+      CachedReadWithoutBlockCallback callback);
+
   using GetEstimateGasCallback =
       base::OnceCallback<void(const std::string& result,
                               mojom::ProviderError error,
@@ -294,6 +308,7 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   bool HasRequestFromOrigin(const GURL& origin) const;
   void RemoveChainIdRequest(const std::string& chain_id);
   void OnGetBlockNumber(
+      const GURL& network_url,
       GetBlockNumberCallback callback,
       const int status,
       const std::string& body,
@@ -414,6 +429,23 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
                        bool auto_retry_on_network_change,
                        const GURL& network_url,
                        RequestIntermediateCallback callback);
+  // Used by |request_batcher_| to send single calls and batches.
+  void SendBatchableRequest(const GURL& network_url,
+                            const std::string& json_payload,
+                            RequestIntermediateCallback callback);
+  // Serves reads from |response_cache_| when the chain has not moved since
+  // the response was stored, otherwise sends them through the batcher.
+  void RequestCachedRead(const GURL& network_url,
+                         const std::string& json_payload,
+                         RequestIntermediateCallback callback);
+  void OnCachedReadResult(
+      const GURL& network_url,
+      const std::string& block,
+      const std::string& json_payload,
+      RequestIntermediateCallback callback,
+      const int status,
+      const std::string& body,
+      const base::flat_map<std::string, std::string>& headers);
   void OnEthChainIdValidatedForOrigin(
       mojom::NetworkInfoPtr chain,
       const GURL& origin,
@@ -426,6 +458,7 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
 
   FRIEND_TEST_ALL_PREFIXES(JsonRpcServiceUnitTest, IsValidDomain);
   FRIEND_TEST_ALL_PREFIXES(JsonRpcServiceUnitTest, Reset);
+  FRIEND_TEST_ALL_PREFIXES(JsonRpcServiceUnitTest, ResponseCache);
   bool IsValidDomain(const std::string& domain);
 
   void OnGetERC721OwnerOf(
@@ -464,6 +497,7 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
   void OnGetSolanaLatestBlockhash(
+      const GURL& network_url,
       GetSolanaLatestBlockhashCallback callback,
       const int status,
       const std::string& body,
@@ -485,6 +519,11 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       const base::flat_map<std::string, std::string>& headers);
 
   std::unique_ptr<api_request_helper::APIRequestHelper> api_request_helper_;
+  // Read-only calls issued by the wallet UI go through this batcher.
+  std::unique_ptr<JsonRpcRequestBatcher> request_batcher_;
+  JsonRpcResponseCache response_cache_;
+  base::RepeatingCallbackList<void(mojom::CoinType coin)>
+      cached_read_without_block_callbacks_;
   base::flat_map<mojom::CoinType, GURL> network_urls_;
   // <mojom::CoinType, chain_id>
   base::flat_map<mojom::CoinType, std::string> chain_ids_;
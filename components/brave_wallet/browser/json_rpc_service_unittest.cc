@@ -420,6 +420,32 @@ class JsonRpcServiceUnitTest : public testing::Test {
         }));
   }
 
+  // Answers eth_blockNumber with |*block_number| and counts eth_getBalance
+  // requests in |*balance_requests|.
+  void SetBlockNumberAndBalanceInterceptor(const std::string* block_number,
+                                           size_t* balance_requests) {
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&, block_number,
+         balance_requests](const network::ResourceRequest& request) {
+          base::StringPiece request_string(request.request_body->elements()
+                                               ->at(0)
+                                               .As<network::DataElementBytes>()
+                                               .AsStringPiece());
+          url_loader_factory_.ClearResponses();
+          std::string result = "\"0x1\"";
+          if (request_string.find("eth_blockNumber") != std::string::npos) {
+            result = "\"" + *block_number + "\"";
+          } else if (request_string.find("eth_getBalance") !=
+                     std::string::npos) {
+            ++*balance_requests;
+            result = "\"0xb539d5\"";
+          }
+          url_loader_factory_.AddResponse(
+              request.url.spec(),
+              "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":" + result + "}");
+        }));
+  }
+
   void SetInvalidJsonInterceptor() {
     url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
         [&](const network::ResourceRequest& request) {
@@ -2230,6 +2256,75 @@ TEST_F(JsonRpcServiceUnitTest, Reset) {
   EXPECT_TRUE(json_rpc_service_->switch_chain_callbacks_.empty());
 }
 
+TEST_F(JsonRpcServiceUnitTest, ResponseCache) {
+  std::string block_number = "0x1";
+  size_t balance_requests = 0;
+  SetBlockNumberAndBalanceInterceptor(&block_number, &balance_requests);
+  auto get_block_number = [&]() {
+    base::RunLoop run_loop;
+    json_rpc_service_->GetBlockNumber(base::BindLambdaForTesting(
+        [&](uint256_t result, mojom::ProviderError error,
+            const std::string& error_message) {
+          EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+  };
+  auto get_balance = [&]() {
+    base::RunLoop run_loop;
+    json_rpc_service_->GetBalance(
+        "0x4e02f254184E904300e0775E4b8eeCB1", mojom::CoinType::ETH,
+        mojom::kLocalhostChainId,
+        base::BindLambdaForTesting([&](const std::string& balance,
+                                       mojom::ProviderError error,
+                                       const std::string& error_message) {
+          EXPECT_EQ(balance, "0xb539d5");
+          EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+  };
+
+  // Nothing is cached until a block has been observed.
+  get_balance();
+  get_balance();
+  EXPECT_EQ(balance_requests, 2u);
+
+  get_block_number();
+  get_balance();
+  get_balance();
+  EXPECT_EQ(balance_requests, 3u);
+  EXPECT_EQ(json_rpc_service_->response_cache_.hit_count(), 1u);
+
+  // A new block invalidates the cached balance.
+  block_number = "0x2";
+  get_block_number();
+  get_balance();
+  get_balance();
+  EXPECT_EQ(balance_requests, 4u);
+
+  // So does a transaction we submit.
+  base::RunLoop run_loop;
+  json_rpc_service_->SendRawTransaction(
+      "0xf869", base::BindLambdaForTesting([&](const std::string& tx_hash,
+                                               mojom::ProviderError error,
+                                               const std::string& message) {
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+  get_balance();
+  EXPECT_EQ(balance_requests, 5u);
+
+  // And switching chains.
+  get_block_number();
+  get_balance();
+  EXPECT_EQ(balance_requests, 6u);
+  EXPECT_TRUE(SetNetwork(mojom::kMainnetChainId, mojom::CoinType::ETH));
+  EXPECT_TRUE(SetNetwork(mojom::kLocalhostChainId, mojom::CoinType::ETH));
+  get_balance();
+  EXPECT_EQ(balance_requests, 7u);
+}
+
 TEST_F(JsonRpcServiceUnitTest, GetSolanaBalance) {
   auto expected_network =
       GetNetwork(mojom::kSolanaMainnet, mojom::CoinType::SOL);
@@ -2727,4 +2822,40 @@ TEST_F(JsonRpcServiceUnitTest, GetFilTransactionCount) {
   EXPECT_TRUE(callback_called);
 }
 
+TEST_F(JsonRpcServiceUnitTest, BatchMethodsHeader) {
+  std::vector<std::string> methods;
+  url_loader_factory_.SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        std::string header_value;
+        EXPECT_TRUE(request.headers.GetHeader("X-Eth-Method", &header_value));
+        methods.push_back(header_value);
+        url_loader_factory_.ClearResponses();
+        url_loader_factory_.AddResponse(request.url.spec(), "",
+                                        net::HTTP_INTERNAL_SERVER_ERROR);
+      }));
+
+  size_t callback_count = 0;
+  json_rpc_service_->GetBalance(
+      "0x4e02f254184E904300e0775E4b8eeCB1", mojom::CoinType::ETH,
+      mojom::kMainnetChainId,
+      base::BindLambdaForTesting(
+          [&](const std::string&, mojom::ProviderError, const std::string&) {
+            ++callback_count;
+          }));
+  json_rpc_service_->GetERC20TokenBalance(
+      "0x0d8775f648430679a709e98d2b0cb6250d2887ef",
+      "0x4e02f254184E904300e0775E4b8eeCB1", mojom::kMainnetChainId,
+      base::BindLambdaForTesting(
+          [&](const std::string&, mojom::ProviderError, const std::string&) {
+            ++callback_count;
+          }));
+  base::RunLoop().RunUntilIdle();
+
+  // The rejected batch, then each call on its own.
+  EXPECT_EQ(methods, std::vector<std::string>(
+                         {"eth_call,eth_getBalance", "eth_getBalance",
+                          "eth_call"}));
+  EXPECT_EQ(callback_count, 2u);
+}
+
 }  // namespace brave_wallet
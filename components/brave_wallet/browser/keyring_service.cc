@@ -15,6 +15,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/value_iterators.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
@@ -595,7 +596,11 @@ HDKeyring* KeyringService::ResumeKeyring(const std::string& keyring_id,
   if (!CreateEncryptorForKeyring(password, keyring_id)) {
     return nullptr;
   }
+  return ResumeKeyringInternal(keyring_id);
+}
 
+HDKeyring* KeyringService::ResumeKeyringInternal(
+    const std::string& keyring_id) {
   const std::string mnemonic = GetMnemonicForKeyringImpl(keyring_id);
   bool is_legacy_brave_wallet = false;
   const base::Value* value =
@@ -1420,6 +1425,8 @@ absl::optional<std::string> KeyringService::GetSelectedAccount(
 }
 
 void KeyringService::Lock() {
+  // Drops keys still being derived for an unlock, also while locked.
+  ++lock_generation_;
   if (IsLocked(mojom::kDefaultKeyringId))
     return;
 
@@ -1447,24 +1454,61 @@ bool KeyringService::IsHardwareAccount(const std::string& address) const {
 
 void KeyringService::Unlock(const std::string& password,
                             KeyringService::UnlockCallback callback) {
-  if (!ResumeKeyring(mojom::kDefaultKeyringId, password)) {
+  if (password.empty()) {
+    std::move(callback).Run(false);
+    return;
+  }
+  std::vector<std::vector<uint8_t>> salts = {
+      GetOrCreateSaltForKeyring(mojom::kDefaultKeyringId)};
+  if (IsFilecoinEnabled())
+    salts.push_back(GetOrCreateSaltForKeyring(mojom::kFilecoinKeyringId));
+  if (IsSolanaEnabled())
+    salts.push_back(GetOrCreateSaltForKeyring(mojom::kSolanaKeyringId));
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&KeyringService::DeriveKeysFromPassword, password,
+                     std::move(salts)),
+      base::BindOnce(&KeyringService::OnUnlockKeysDerived,
+                     weak_ptr_factory_.GetWeakPtr(), lock_generation_,
+                     std::move(callback)));
+}
+
+void KeyringService::OnUnlockKeysDerived(size_t lock_generation,
+                                         UnlockCallback callback,
+                                         DerivedKeys keys) {
+  // The wallet was locked or reset while the keys were derived.
+  if (lock_generation != lock_generation_) {
+    std::move(callback).Run(false);
+    return;
+  }
+  encryptors_[mojom::kDefaultKeyringId] =
+      GetDerivedKeyForKeyring(mojom::kDefaultKeyringId, keys);
+  if (!ResumeKeyringInternal(mojom::kDefaultKeyringId)) {
     encryptors_.erase(mojom::kDefaultKeyringId);
     std::move(callback).Run(false);
     return;
   }
-  if (IsFilecoinEnabled() &&
-      !ResumeKeyring(mojom::kFilecoinKeyringId, password)) {
+  if (IsFilecoinEnabled()) {
+    encryptors_[mojom::kFilecoinKeyringId] =
+        GetDerivedKeyForKeyring(mojom::kFilecoinKeyringId, keys);
     // If Filecoin keyring doesnt exist we keep encryptor pre-created
     // to be able to lazily create keyring later
-    if (IsKeyringExist(mojom::kFilecoinKeyringId)) {
+    if (!ResumeKeyringInternal(mojom::kFilecoinKeyringId) &&
+        IsKeyringExist(mojom::kFilecoinKeyringId)) {
       VLOG(1) << __func__ << " Unable to unlock filecoin keyring";
       encryptors_.erase(mojom::kFilecoinKeyringId);
       std::move(callback).Run(false);
       return;
     }
   }
-  if (IsSolanaEnabled() && !ResumeKeyring(mojom::kSolanaKeyringId, password)) {
-    if (IsKeyringExist(mojom::kSolanaKeyringId)) {
+  if (IsSolanaEnabled()) {
+    encryptors_[mojom::kSolanaKeyringId] =
+        GetDerivedKeyForKeyring(mojom::kSolanaKeyringId, keys);
+    if (!ResumeKeyringInternal(mojom::kSolanaKeyringId) &&
+        IsKeyringExist(mojom::kSolanaKeyringId)) {
       VLOG(1) << __func__ << " Unable to unlock Solana keyring";
       encryptors_.erase(mojom::kSolanaKeyringId);
       std::move(callback).Run(false);
@@ -1491,6 +1535,7 @@ void KeyringService::IsLocked(IsLockedCallback callback) {
 }
 
 void KeyringService::Reset(bool notify_observer) {
+  ++lock_generation_;
   StopAutoLockTimer();
   encryptors_.clear();
   keyrings_.clear();
@@ -1557,20 +1602,52 @@ std::vector<uint8_t> KeyringService::GetOrCreateNonceForKeyring(
   return nonce;
 }
 
-bool KeyringService::CreateEncryptorForKeyring(const std::string& password,
-                                               const std::string& id) {
-  if (password.empty())
-    return false;
+std::vector<uint8_t> KeyringService::GetOrCreateSaltForKeyring(
+    const std::string& id) {
   std::vector<uint8_t> salt(kSaltSize);
   if (!GetPrefInBytesForKeyring(kPasswordEncryptorSalt, &salt, id)) {
     crypto::RandBytes(salt);
     SetPrefInBytesForKeyring(kPasswordEncryptorSalt, salt, id);
   }
+  return salt;
+}
+
+bool KeyringService::CreateEncryptorForKeyring(const std::string& password,
+                                               const std::string& id) {
+  if (password.empty())
+    return false;
   encryptors_[id] = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-      password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+      password, GetOrCreateSaltForKeyring(id), kPbkdf2Iterations,
+      kPbkdf2KeySize);
   return encryptors_[id] != nullptr;
 }
 
+// static
+KeyringService::DerivedKeys KeyringService::DeriveKeysFromPassword(
+    const std::string& password,
+    const std::vector<std::vector<uint8_t>>& salts) {
+  DerivedKeys keys;
+  for (const auto& salt : salts) {
+    if (keys.contains(salt))
+      continue;
+    keys[salt] = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+        password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+  }
+  return keys;
+}
+
+std::unique_ptr<PasswordEncryptor> KeyringService::GetDerivedKeyForKeyring(
+    const std::string& id,
+    const DerivedKeys& keys) const {
+  std::vector<uint8_t> salt(kSaltSize);
+  if (!GetPrefInBytesForKeyring(kPasswordEncryptorSalt, &salt, id))
+    return nullptr;
+  auto it = keys.find(salt);
+  if (it == keys.end() || !it->second)
+    return nullptr;
+  return it->second->Clone();
+}
+
 bool KeyringService::CreateKeyringInternal(const std::string& keyring_id,
                                            const std::string& mnemonic,
                                            bool is_legacy_brave_wallet) {
@@ -1860,18 +1937,35 @@ void KeyringService::ValidatePassword(const std::string& password,
     return;
   }
 
-  const std::string keyring_id = mojom::kDefaultKeyringId;
-
   std::vector<uint8_t> salt(kSaltSize);
-  if (!GetPrefInBytesForKeyring(kPasswordEncryptorSalt, &salt, keyring_id)) {
+  if (!GetPrefInBytesForKeyring(kPasswordEncryptorSalt, &salt,
+                                mojom::kDefaultKeyringId)) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&KeyringService::DeriveKeysFromPassword, password,
+                     std::vector<std::vector<uint8_t>>{std::move(salt)}),
+      base::BindOnce(&KeyringService::OnValidatePasswordKeyDerived,
+                     weak_ptr_factory_.GetWeakPtr(), lock_generation_,
+                     std::move(callback)));
+}
+
+void KeyringService::OnValidatePasswordKeyDerived(
+    size_t lock_generation,
+    ValidatePasswordCallback callback,
+    DerivedKeys keys) {
+  if (lock_generation != lock_generation_) {
     std::move(callback).Run(false);
     return;
   }
+  const std::string keyring_id = mojom::kDefaultKeyringId;
 
-  // TODO(apaymyshev): move this call(and other ones in this file) to background
-  // thread.
-  auto encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-      password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+  auto encryptor = GetDerivedKeyForKeyring(keyring_id, keys);
   if (!encryptor) {
     std::move(callback).Run(false);
     return;
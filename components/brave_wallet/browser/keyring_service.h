@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -248,6 +249,8 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest,
                            GetMnemonicForDefaultKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, LockAndUnlock);
+  FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest,
+                           UnlockDerivesKeysOffUISequence);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, Reset);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, AccountMetasForKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, CreateAndRestoreWallet);
@@ -276,6 +279,10 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   friend class EthTxManagerUnitTest;
   friend class FilTxManagerUnitTest;
 
+  // <salt, key derived from the password with that salt>
+  using DerivedKeys =
+      base::flat_map<std::vector<uint8_t>, std::unique_ptr<PasswordEncryptor>>;
+
   void AddAccountForKeyring(const std::string& keyring_id,
                             const std::string& account_name);
   void AddDiscoveryAccountsForKeyring(size_t discovery_account_index,
@@ -310,8 +317,14 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
                                 base::span<const uint8_t> bytes,
                                 const std::string& id);
   std::vector<uint8_t> GetOrCreateNonceForKeyring(const std::string& id);
+  std::vector<uint8_t> GetOrCreateSaltForKeyring(const std::string& id);
   bool CreateEncryptorForKeyring(const std::string& password,
                                  const std::string& id);
+  // Returns the key derived for the salt currently stored for keyring |id|,
+  // nullptr if the salt was replaced while |keys| were being derived.
+  std::unique_ptr<PasswordEncryptor> GetDerivedKeyForKeyring(
+      const std::string& id,
+      const DerivedKeys& keys) const;
   bool CreateKeyringInternal(const std::string& keyring_id,
                              const std::string& mnemonic,
                              bool is_legacy_brave_wallet);
@@ -328,6 +341,22 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   // It's used to reconstruct same default keyring between browser relaunch
   HDKeyring* ResumeKeyring(const std::string& keyring_id,
                            const std::string& password);
+  // Same as ResumeKeyring but uses the encryptor already set for the keyring.
+  HDKeyring* ResumeKeyringInternal(const std::string& keyring_id);
+  // Runs PBKDF2 once per distinct salt, one after the other. Every keyring
+  // has its own random salt, so an unlock derives one key per keyring. It
+  // takes long enough to be kept off the UI sequence.
+  static DerivedKeys DeriveKeysFromPassword(
+      const std::string& password,
+      const std::vector<std::vector<uint8_t>>& salts);
+  // |lock_generation| is |lock_generation_| when the derivation started, the
+  // keys are dropped if the wallet was locked or reset since.
+  void OnUnlockKeysDerived(size_t lock_generation,
+                           UnlockCallback callback,
+                           DerivedKeys keys);
+  void OnValidatePasswordKeyDerived(size_t lock_generation,
+                                    ValidatePasswordCallback callback,
+                                    DerivedKeys keys);
 
   void NotifyAccountsChanged();
   void StopAutoLockTimer();
@@ -350,11 +379,14 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   raw_ptr<JsonRpcService> json_rpc_service_;
   raw_ptr<PrefService> prefs_ = nullptr;
   bool request_unlock_pending_ = false;
+  // Bumped by Lock and Reset.
+  size_t lock_generation_ = 0;
 
   mojo::RemoteSet<mojom::KeyringServiceObserver> observers_;
   mojo::ReceiverSet<mojom::KeyringService> receivers_;
 
   base::WeakPtrFactory<KeyringService> discovery_weak_factory_{this};
+  base::WeakPtrFactory<KeyringService> weak_ptr_factory_{this};
 
   KeyringService(const KeyringService&) = delete;
   KeyringService& operator=(const KeyringService&) = delete;
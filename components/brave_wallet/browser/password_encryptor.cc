@@ -43,6 +43,10 @@ PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
   return rv == 1 ? std::move(encryptor) : nullptr;
 }
 
+std::unique_ptr<PasswordEncryptor> PasswordEncryptor::Clone() const {
+  return std::unique_ptr<PasswordEncryptor>(new PasswordEncryptor(key_));
+}
+
 bool PasswordEncryptor::Encrypt(base::span<const uint8_t> plaintext,
                                 base::span<const uint8_t> nonce,
                                 std::vector<uint8_t>* ciphertext) {
@@ -27,6 +27,9 @@ class PasswordEncryptor {
       size_t iterations,
       size_t key_size_in_bits);
 
+  // Lets keyrings sharing a salt reuse one derivation.
+  std::unique_ptr<PasswordEncryptor> Clone() const;
+
   bool Encrypt(base::span<const uint8_t> plaintext,
                base::span<const uint8_t> nonce,
                std::vector<uint8_t>* ciphertext);
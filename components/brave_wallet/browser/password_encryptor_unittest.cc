@@ -77,6 +77,12 @@ TEST(PasswordEncryptorUnitTest, EncryptAndDecrypt) {
       PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
           "password", ToSpan("salt"), 200, 256);
   EXPECT_FALSE(encryptor4->Decrypt(ciphertext, nonce, &plaintext));
+
+  // clone uses the same key
+  plaintext.clear();
+  std::unique_ptr<PasswordEncryptor> encryptor5 = encryptor->Clone();
+  EXPECT_TRUE(encryptor5->Decrypt(ciphertext, nonce, &plaintext));
+  EXPECT_EQ(std::string(plaintext.begin(), plaintext.end()), "bravo");
 }
 
 TEST(PasswordEncryptorUnitTest, DecryptForImporter) {
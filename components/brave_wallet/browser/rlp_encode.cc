@@ -8,34 +8,48 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/check.h"
+
+namespace brave_wallet {
+
 namespace {
 
-std::string RLPToBinary(size_t x) {
-  if (x == 0) {
-    return "";
+// Inserts the length prefix for |length| bytes of payload at |pos|.
+void RLPInsertLength(size_t length,
+                     uint8_t offset,
+                     std::vector<uint8_t>* output,
+                     std::vector<uint8_t>::iterator pos) {
+  if (length < 56) {
+    output->insert(pos, static_cast<uint8_t>(length + offset));
+    return;
   }
-  std::string ret = RLPToBinary(x / 256);
-  ret.push_back(x % 256);
-  return ret;
+  uint8_t prefix[RLPWriter::kMaxLengthPrefixSize];
+  size_t prefix_length = 1;
+  for (size_t x = length; x > 0; x /= 256)
+    ++prefix_length;
+  for (size_t i = prefix_length - 1, x = length; i > 0; --i, x /= 256)
+    prefix[i] = static_cast<uint8_t>(x % 256);
+  prefix[0] = static_cast<uint8_t>(prefix_length - 1 + offset + 55);
+  output->insert(pos, prefix, prefix + prefix_length);
 }
 
-std::string RLPEncodeLength(size_t length, size_t offset) {
-  char sz[2] = {0};
-  if (length < 56) {
-    sz[0] = length + offset;
-    return sz;
+void RLPWriteValue(const base::Value& val, RLPWriter* writer) {
+  if (val.is_int()) {
+    writer->AddUint256((uint256_t)val.GetInt());
+  } else if (val.is_blob()) {
+    writer->AddBytes(val.GetBlob());
+  } else if (val.is_string()) {
+    writer->AddString(val.GetString());
+  } else if (val.is_list()) {
+    writer->BeginList();
+    for (const auto& item : val.GetList())
+      RLPWriteValue(item, writer);
+    writer->EndList();
   }
-  std::string BL = RLPToBinary(length);
-  sz[0] = BL.length() + offset + 55;
-  std::string ret(sz);
-  ret.append(BL);
-  return ret;
 }
 
 }  // namespace
 
-namespace brave_wallet {
-
 base::Value RLPUint256ToBlobValue(uint256_t input) {
   base::Value::BlobStorage output;
   while (input > static_cast<uint256_t>(0)) {
@@ -49,27 +63,60 @@ base::Value RLPUint256ToBlobValue(uint256_t input) {
 }
 
 std::string RLPEncode(base::Value val) {
-  if (val.is_int()) {
-    int i = val.GetInt();
-    return RLPEncode(base::Value(RLPUint256ToBlobValue((uint256_t)i)));
-  } else if (val.is_blob()) {
-    base::Value::BlobStorage blob = val.GetBlob();
-    std::string s(blob.begin(), blob.end());
-    if (blob.size() == 1 && static_cast<uint8_t>(blob[0]) < 0x80) {
-      return s;
-    }
-    return RLPEncodeLength(blob.size(), 0x80) + s;
-  } else if (val.is_string()) {
-    std::string s = val.GetString();
-    return RLPEncode(base::Value(base::Value::BlobStorage(s.begin(), s.end())));
-  } else if (val.is_list()) {
-    std::string output;
-    for (auto& item : val.GetList()) {
-      output += RLPEncode(std::move(item));
-    }
-    return RLPEncodeLength(output.length(), 0xc0) + output;
+  if (!val.is_int() && !val.is_blob() && !val.is_string() && !val.is_list())
+    return "";
+  RLPWriter writer;
+  RLPWriteValue(val, &writer);
+  return std::string(writer.output().begin(), writer.output().end());
+}
+
+RLPWriter::RLPWriter() = default;
+RLPWriter::~RLPWriter() = default;
+
+void RLPWriter::Reserve(size_t size) {
+  output_.reserve(size);
+}
+
+void RLPWriter::AddBytes(base::span<const uint8_t> bytes) {
+  if (bytes.size() == 1 && bytes[0] < 0x80) {
+    output_.push_back(bytes[0]);
+    return;
+  }
+  RLPInsertLength(bytes.size(), 0x80, &output_, output_.end());
+  output_.insert(output_.end(), bytes.begin(), bytes.end());
+}
+
+void RLPWriter::AddString(base::StringPiece str) {
+  AddBytes(base::as_bytes(base::make_span(str)));
+}
+
+void RLPWriter::AddUint256(uint256_t input) {
+  // Big endian without leading zeros
+  uint8_t bytes[32];
+  size_t size = 0;
+  for (; input > static_cast<uint256_t>(0); input >>= 8) {
+    bytes[sizeof(bytes) - 1 - size] =
+        static_cast<uint8_t>(input & static_cast<uint256_t>(0xFF));
+    ++size;
   }
-  return "";
+  AddBytes(base::make_span(bytes + sizeof(bytes) - size, size));
+}
+
+void RLPWriter::BeginList() {
+  list_offsets_.push_back(output_.size());
+}
+
+void RLPWriter::EndList() {
+  DCHECK(!list_offsets_.empty());
+  const size_t offset = list_offsets_.back();
+  list_offsets_.pop_back();
+  RLPInsertLength(output_.size() - offset, 0xc0, &output_,
+                  output_.begin() + offset);
+}
+
+const std::vector<uint8_t>& RLPWriter::output() const {
+  DCHECK(list_offsets_.empty());
+  return output_;
 }
 
 }  // namespace brave_wallet
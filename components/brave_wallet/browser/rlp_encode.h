@@ -7,7 +7,10 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_RLP_ENCODE_H_
 
 #include <string>
+#include <vector>
 
+#include "base/containers/span.h"
+#include "base/strings/string_piece.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
 
@@ -20,6 +23,41 @@ base::Value RLPUint256ToBlobValue(uint256_t input);
 // blob, or int data
 std::string RLPEncode(base::Value val);
 
+// Writes the RLP encoding of items directly into one byte buffer, without
+// building a base::Value for every item. Nested lists are written between
+// BeginList and EndList calls.
+class RLPWriter {
+ public:
+  RLPWriter();
+  ~RLPWriter();
+  RLPWriter(const RLPWriter&) = delete;
+  RLPWriter& operator=(const RLPWriter&) = delete;
+
+  // Longest length prefix of an item or a list: one byte followed by up to
+  // eight bytes of length
+  static constexpr size_t kMaxLengthPrefixSize = 1 + sizeof(size_t);
+
+  // Reserves room for |size| bytes of output. EndList inserts the list's
+  // header in front of its payload, so |size| must count up to
+  // kMaxLengthPrefixSize bytes for every list for the buffer not to grow.
+  void Reserve(size_t size);
+
+  void AddBytes(base::span<const uint8_t> bytes);
+  void AddString(base::StringPiece str);
+  void AddUint256(uint256_t input);
+
+  void BeginList();
+  void EndList();
+
+  // Returns the encoding, all lists must have been ended
+  const std::vector<uint8_t>& output() const;
+
+ private:
+  std::vector<uint8_t> output_;
+  // Offsets in |output_| where the open lists' payloads start
+  std::vector<size_t> list_offsets_;
+};
+
 }  // namespace brave_wallet
 
 #endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_RLP_ENCODE_H_
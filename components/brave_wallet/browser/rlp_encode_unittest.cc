@@ -391,4 +391,76 @@ TEST(RLPEncodeTest, DictionaryValueNotSupported) {
   ASSERT_TRUE(brave_wallet::RLPEncode(std::move(d)).empty());
 }
 
+TEST(RLPEncodeTest, Writer) {
+  brave_wallet::RLPWriter writer;
+  writer.BeginList();
+  writer.AddString("cat");
+  writer.BeginList();
+  writer.AddString("puppy");
+  writer.AddString("cow");
+  writer.EndList();
+  writer.AddString("horse");
+  writer.BeginList();
+  writer.BeginList();
+  writer.EndList();
+  writer.EndList();
+  writer.AddString("pig");
+  writer.BeginList();
+  writer.AddString("");
+  writer.EndList();
+  writer.AddString("sheep");
+  writer.EndList();
+  ASSERT_EQ(ToHex(writer.output()),
+            "0xe383636174ca85707570707983636f7785686f727365c1c083706967c1808573"
+            "68656570");
+}
+
+TEST(RLPEncodeTest, WriterMatchesValue) {
+  brave_wallet::uint256_t big_int;
+  ASSERT_TRUE(brave_wallet::HexValueToUint256(
+      "0x100102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+      &big_int));
+  const std::string long_string(1024, 'a');
+
+  brave_wallet::RLPWriter writer;
+  writer.BeginList();
+  writer.AddUint256(0);
+  writer.AddUint256(127);
+  writer.AddUint256(1024);
+  writer.AddUint256(big_int);
+  writer.AddBytes(std::vector<uint8_t>{0x00});
+  writer.AddString(long_string);
+  writer.EndList();
+
+  base::ListValue list;
+  list.Append(brave_wallet::RLPUint256ToBlobValue(0));
+  list.Append(brave_wallet::RLPUint256ToBlobValue(127));
+  list.Append(brave_wallet::RLPUint256ToBlobValue(1024));
+  list.Append(brave_wallet::RLPUint256ToBlobValue(big_int));
+  list.Append(base::Value(base::Value::BlobStorage{0x00}));
+  list.Append(base::Value(long_string));
+  const std::string v = brave_wallet::RLPEncode(std::move(list));
+  EXPECT_EQ(ToHex(writer.output()), ToHex(v));
+  // Long list of a short and a long string.
+  EXPECT_EQ(ToHex(v).substr(0, 8), "0xf9042a");
+}
+
+TEST(RLPEncodeTest, WriterReserveCoversListHeaders) {
+  const std::vector<uint8_t> data(70000, 0xab);
+  brave_wallet::RLPWriter writer;
+  // The data and its length prefix, and the headers of the two lists.
+  writer.Reserve(data.size() +
+                 3 * brave_wallet::RLPWriter::kMaxLengthPrefixSize);
+  const size_t capacity = writer.output().capacity();
+  writer.BeginList();
+  writer.BeginList();
+  writer.AddBytes(data);
+  writer.EndList();
+  writer.EndList();
+
+  // Inserting the list headers didn't grow the buffer.
+  EXPECT_EQ(writer.output().capacity(), capacity);
+  EXPECT_EQ(ToHex(writer.output()).substr(0, 20), "0xfa011178fa011174ba");
+}
+
 }  // namespace brave_wallet
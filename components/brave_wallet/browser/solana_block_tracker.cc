@@ -46,30 +46,39 @@ void SolanaBlockTracker::GetLatestBlockhash(GetLatestBlockhashCallback callback,
     return;
   }
 
+  if (callback)
+    pending_callbacks_.push_back(std::move(callback));
+  if (latest_blockhash_request_pending_)
+    return;
+
+  latest_blockhash_request_pending_ = true;
   json_rpc_service_->GetSolanaLatestBlockhash(
       base::BindOnce(&SolanaBlockTracker::OnGetLatestBlockhash,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+                     weak_ptr_factory_.GetWeakPtr()));
 }
 
 void SolanaBlockTracker::OnGetLatestBlockhash(
-    GetLatestBlockhashCallback callback,
     const std::string& latest_blockhash,
     mojom::SolanaProviderError error,
     const std::string& error_message) {
-  if (callback)
-    std::move(callback).Run(latest_blockhash, error, error_message);
-
+  latest_blockhash_request_pending_ = false;
+  bool updated = false;
   if (error != mojom::SolanaProviderError::kSuccess) {
     VLOG(1) << __FUNCTION__ << ": Failed to get latest blockhash, error: "
             << static_cast<int>(error) << ", error_message: " << error_message;
-    return;
+  } else if (latest_blockhash_ != latest_blockhash) {
+    latest_blockhash_ = latest_blockhash;
+    latest_blockhash_expired_time_ = base::Time::Now() + kExpiredTimeDelta;
+    updated = true;
   }
 
-  if (latest_blockhash_ == latest_blockhash)
-    return;
+  std::vector<GetLatestBlockhashCallback> callbacks;
+  callbacks.swap(pending_callbacks_);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(latest_blockhash, error, error_message);
 
-  latest_blockhash_ = latest_blockhash;
-  latest_blockhash_expired_time_ = base::Time::Now() + kExpiredTimeDelta;
+  if (!updated)
+    return;
   for (auto& observer : observers_)
     observer.OnLatestBlockhashUpdated(latest_blockhash);
 }
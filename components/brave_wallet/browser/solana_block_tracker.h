@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_SOLANA_BLOCK_TRACKER_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
@@ -44,17 +45,20 @@ class SolanaBlockTracker : public BlockTracker {
       base::OnceCallback<void(const std::string& latest_blockhash,
                               mojom::SolanaProviderError error,
                               const std::string& error_message)>;
+  // Requests made while one is in flight wait for its result instead of
+  // sending another.
   void GetLatestBlockhash(GetLatestBlockhashCallback callback,
                           bool try_cached_value);
 
  private:
-  void OnGetLatestBlockhash(GetLatestBlockhashCallback callback,
-                            const std::string& latest_blockhash,
+  void OnGetLatestBlockhash(const std::string& latest_blockhash,
                             mojom::SolanaProviderError error,
                             const std::string& error_message);
 
   std::string latest_blockhash_;
   base::Time latest_blockhash_expired_time_;
+  bool latest_blockhash_request_pending_ = false;
+  std::vector<GetLatestBlockhashCallback> pending_callbacks_;
   base::ObserverList<Observer> observers_;
 
   base::WeakPtrFactory<SolanaBlockTracker> weak_ptr_factory_;
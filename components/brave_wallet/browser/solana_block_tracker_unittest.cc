@@ -239,4 +239,36 @@ TEST_F(SolanaBlockTrackerUnitTest, GetLatestBlockhashWithoutStartTracker) {
                          l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR));
 }
 
+TEST_F(SolanaBlockTrackerUnitTest, ConcurrentGetLatestBlockhash) {
+  size_t request_count = 0;
+  url_loader_factory_.SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        ++request_count;
+        url_loader_factory_.ClearResponses();
+        url_loader_factory_.AddResponse(request.url.spec(),
+                                        GetResponseString());
+      }));
+  response_blockhash_ = "hash1";
+  TrackerObserver observer;
+  tracker_->AddObserver(&observer);
+
+  // Callers waiting on the same uncached blockhash share one request.
+  size_t callback_count = 0;
+  for (int i = 0; i < 10; ++i) {
+    tracker_->GetLatestBlockhash(
+        base::BindLambdaForTesting([&](const std::string& latest_blockhash,
+                                       mojom::SolanaProviderError error,
+                                       const std::string& error_message) {
+          EXPECT_EQ(latest_blockhash, "hash1");
+          EXPECT_EQ(error, mojom::SolanaProviderError::kSuccess);
+          ++callback_count;
+        }),
+        false);
+  }
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(callback_count, 10u);
+  EXPECT_EQ(request_count, 1u);
+  EXPECT_EQ(observer.latest_blockhash_updated_fired(), 1u);
+}
+
 }  // namespace brave_wallet
@@ -34,13 +34,8 @@ void SolanaKeyring::ConstructRootHDKey(const std::vector<uint8_t>& seed,
   }
 }
 
-void SolanaKeyring::AddAccounts(size_t number) {
-  size_t cur_accounts_number = accounts_.size();
-  for (size_t i = cur_accounts_number; i < cur_accounts_number + number; ++i) {
-    if (root_) {
-      accounts_.push_back(root_->DeriveChild(i)->DeriveChild(0));
-    }
-  }
+std::unique_ptr<HDKeyBase> SolanaKeyring::DeriveAccount(size_t index) const {
+  return root_->DeriveChild(index)->DeriveChild(0);
 }
 
 std::string SolanaKeyring::ImportAccount(const std::vector<uint8_t>& keypair) {
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_wallet/browser/solana_tx_manager.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -22,11 +23,19 @@
 
 namespace brave_wallet {
 
+namespace {
+
+// Maximum number of signatures getSignatureStatuses accepts in one call.
+constexpr size_t kMaxSignatureStatusesBatchSize = 256;
+
+}  // namespace
+
 SolanaTxManager::SolanaTxManager(TxService* tx_service,
                                  JsonRpcService* json_rpc_service,
                                  KeyringService* keyring_service,
                                  PrefService* prefs)
-    : TxManager(std::make_unique<SolanaTxStateManager>(prefs, json_rpc_service),
+    : TxManager(mojom::CoinType::SOL,
+                std::make_unique<SolanaTxStateManager>(prefs, json_rpc_service),
                 std::make_unique<SolanaBlockTracker>(json_rpc_service),
                 tx_service,
                 json_rpc_service,
@@ -154,18 +163,32 @@ void SolanaTxManager::OnSendSolanaTransaction(
 void SolanaTxManager::UpdatePendingTransactions() {
   auto pending_transactions = tx_state_manager_->GetTransactionsByStatus(
       mojom::TransactionStatus::Submitted, absl::nullopt);
-  std::vector<std::string> tx_meta_ids;
-  std::vector<std::string> tx_signatures;
-  for (const auto& pending_transaction : pending_transactions) {
-    tx_meta_ids.push_back(pending_transaction->id());
-    tx_signatures.push_back(pending_transaction->tx_hash());
-  }
-  json_rpc_service_->GetSolanaSignatureStatuses(
-      tx_signatures,
-      base::BindOnce(&SolanaTxManager::OnGetSignatureStatuses,
-                     weak_ptr_factory_.GetWeakPtr(), tx_meta_ids));
   known_no_pending_tx_ = pending_transactions.empty();
   CheckIfBlockTrackerShouldRun();
+
+  // The statuses are checked again once the calls in flight are done.
+  if (signature_statuses_requests_pending_) {
+    update_pending_transactions_again_ = true;
+    return;
+  }
+
+  // Query all pending signatures of the network in as few calls as possible.
+  for (size_t start = 0; start < pending_transactions.size();
+       start += kMaxSignatureStatusesBatchSize) {
+    const size_t end = std::min(start + kMaxSignatureStatusesBatchSize,
+                                pending_transactions.size());
+    std::vector<std::string> tx_meta_ids;
+    std::vector<std::string> tx_signatures;
+    for (size_t i = start; i < end; ++i) {
+      tx_meta_ids.push_back(pending_transactions[i]->id());
+      tx_signatures.push_back(pending_transactions[i]->tx_hash());
+    }
+    ++signature_statuses_requests_pending_;
+    json_rpc_service_->GetSolanaSignatureStatuses(
+        tx_signatures,
+        base::BindOnce(&SolanaTxManager::OnGetSignatureStatuses,
+                       weak_ptr_factory_.GetWeakPtr(), tx_meta_ids));
+  }
 }
 
 void SolanaTxManager::OnGetSignatureStatuses(
@@ -174,12 +197,25 @@ void SolanaTxManager::OnGetSignatureStatuses(
         signature_statuses,
     mojom::SolanaProviderError error,
     const std::string& error_message) {
-  if (error != mojom::SolanaProviderError::kSuccess)
-    return;
+  DCHECK_GT(signature_statuses_requests_pending_, 0u);
+  --signature_statuses_requests_pending_;
 
-  if (tx_meta_ids.size() != signature_statuses.size())
-    return;
+  if (error == mojom::SolanaProviderError::kSuccess &&
+      tx_meta_ids.size() == signature_statuses.size()) {
+    UpdateSignatureStatuses(tx_meta_ids, signature_statuses);
+  }
+
+  if (!signature_statuses_requests_pending_ &&
+      update_pending_transactions_again_) {
+    update_pending_transactions_again_ = false;
+    UpdatePendingTransactions();
+  }
+}
 
+void SolanaTxManager::UpdateSignatureStatuses(
+    const std::vector<std::string>& tx_meta_ids,
+    const std::vector<absl::optional<SolanaSignatureStatus>>&
+        signature_statuses) {
   for (size_t i = 0; i < tx_meta_ids.size(); i++) {
     std::unique_ptr<SolanaTxMeta> meta =
         GetSolanaTxStateManager()->GetSolanaTx(tx_meta_ids[i]);
@@ -195,6 +231,10 @@ void SolanaTxManager::OnGetSignatureStatuses(
 
     // Update SolanaTxMeta with signature status.
     if (!signature_statuses[i]->confirmation_status.empty()) {
+      // Nothing changed since the last poll, don't rewrite the tx.
+      if (meta->signature_status() == *signature_statuses[i])
+        continue;
+
       meta->set_signature_status(*signature_statuses[i]);
 
       if (signature_statuses[i]->confirmation_status == "finalized") {
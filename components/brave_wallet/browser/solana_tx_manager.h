@@ -78,6 +78,13 @@ class SolanaTxManager : public TxManager, public SolanaBlockTracker::Observer {
 
  private:
   FRIEND_TEST_ALL_PREFIXES(SolanaTxManagerUnitTest, AddAndApproveTransaction);
+  FRIEND_TEST_ALL_PREFIXES(SolanaTxManagerUnitTest, ManyPendingTransactions);
+  FRIEND_TEST_ALL_PREFIXES(SolanaTxManagerUnitTest,
+                           UnchangedSignatureStatusIsNotRewritten);
+  FRIEND_TEST_ALL_PREFIXES(SolanaTxManagerUnitTest,
+                           BlockTrackerRequestsPerHour);
+  FRIEND_TEST_ALL_PREFIXES(SolanaTxManagerUnitTest,
+                           BlockTrackerRunsWhileCacheIsRead);
 
   // TxManager
   void UpdatePendingTransactions() override;
@@ -98,6 +105,10 @@ class SolanaTxManager : public TxManager, public SolanaBlockTracker::Observer {
           signature_statuses,
       mojom::SolanaProviderError error,
       const std::string& error_message);
+  void UpdateSignatureStatuses(
+      const std::vector<std::string>& tx_meta_ids,
+      const std::vector<absl::optional<SolanaSignatureStatus>>&
+          signature_statuses);
   void OnGetAccountInfo(const std::string& spl_token_mint_address,
                         const std::string& from_wallet_address,
                         const std::string& to_wallet_address,
@@ -125,6 +136,11 @@ class SolanaTxManager : public TxManager, public SolanaBlockTracker::Observer {
   SolanaTxStateManager* GetSolanaTxStateManager();
   SolanaBlockTracker* GetSolanaBlockTracker();
 
+  // getSignatureStatuses calls still in flight, a new round of updates
+  // waits for them.
+  size_t signature_statuses_requests_pending_ = 0;
+  bool update_pending_transactions_again_ = false;
+
   base::WeakPtrFactory<SolanaTxManager> weak_ptr_factory_;
 };
 
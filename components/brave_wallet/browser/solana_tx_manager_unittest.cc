@@ -5,23 +5,31 @@
 
 #include "brave/components/brave_wallet/browser/solana_tx_manager.h"
 
+#include <map>
+#include <memory>
+#include <string>
 #include <utility>
 
 #include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/test/bind.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 #include "brave/components/brave_wallet/browser/keyring_service.h"
+#include "brave/components/brave_wallet/browser/pref_names.h"
 #include "brave/components/brave_wallet/browser/solana_block_tracker.h"
 #include "brave/components/brave_wallet/browser/solana_keyring.h"
 #include "brave/components/brave_wallet/browser/solana_transaction.h"
 #include "brave/components/brave_wallet/browser/solana_tx_meta.h"
+#include "brave/components/brave_wallet/browser/solana_tx_state_manager.h"
 #include "brave/components/brave_wallet/browser/tx_service.h"
 #include "brave/components/brave_wallet/common/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
 #include "brave/components/brave_wallet/common/features.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "components/sync_preferences/testing_pref_service_syncable.h"
 #include "services/data_decoder/public/cpp/test_support/in_process_data_decoder.h"
 #include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
@@ -31,6 +39,22 @@
 
 namespace brave_wallet {
 
+namespace {
+
+class TestTxStateManagerObserver : public TxStateManager::Observer {
+ public:
+  void OnTransactionStatusChanged(mojom::TransactionInfoPtr tx_info) override {
+    ++status_changed_count_;
+  }
+
+  size_t status_changed_count() const { return status_changed_count_; }
+
+ private:
+  size_t status_changed_count_ = 0;
+};
+
+}  // namespace
+
 class SolanaTxManagerUnitTest : public testing::Test {
  public:
   SolanaTxManagerUnitTest()
@@ -94,6 +118,7 @@ class SolanaTxManagerUnitTest : public testing::Test {
     url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
         [&, latest_blockhash, tx_hash, content,
          get_signature_statuses](const network::ResourceRequest& request) {
+          ++intercepted_request_count_;
           url_loader_factory_.ClearResponses();
           base::StringPiece request_string(request.request_body->elements()
                                                ->at(0)
@@ -303,6 +328,8 @@ class SolanaTxManagerUnitTest : public testing::Test {
   std::string tx_hash2_;
   std::string latest_blockhash1_;
   std::string latest_blockhash2_;
+  // Requests seen by the interceptor installed with SetInterceptor().
+  size_t intercepted_request_count_ = 0;
 };
 
 TEST_F(SolanaTxManagerUnitTest, AddAndApproveTransaction) {
@@ -397,6 +424,231 @@ TEST_F(SolanaTxManagerUnitTest, AddAndApproveTransaction) {
             SolanaSignatureStatus(72u, 0u, "", "finalized"));
 }
 
+// Polls 300 submitted transactions and counts the JSON-RPC calls it takes.
+TEST_F(SolanaTxManagerUnitTest, ManyPendingTransactions) {
+  constexpr size_t kPendingTxCount = 300;
+  solana_tx_manager()->GetSolanaBlockTracker()->Stop();
+
+  std::string from_account = "BrG44HdsEhzapvs8bEqzvkq4egwevS3fRE6ze2ENo6S8";
+  std::string to_account = "JDqrvDz8d8tFCADashbUKQDKfJZFobNy13ugN65t1wvV";
+  auto solana_tx_data = mojom::SolanaTxData::New(
+      "" /* recent_blockhash */, from_account, to_account,
+      "" /* spl_token_mint_address */, 10000000u /* lamport */, 0 /* amount */,
+      mojom::TransactionType::SolanaSystemTransfer,
+      std::vector<mojom::SolanaInstructionPtr>());
+  for (size_t i = 0; i < kPendingTxCount; ++i) {
+    SolanaTxMeta meta(
+        SolanaTransaction::FromSolanaTxData(solana_tx_data.Clone()));
+    meta.set_id(TxMeta::GenerateMetaID());
+    meta.set_from(from_account);
+    meta.set_status(mojom::TransactionStatus::Submitted);
+    meta.set_tx_hash("hash" + base::NumberToString(i));
+    solana_tx_manager()->GetSolanaTxStateManager()->AddOrUpdateTx(meta);
+  }
+
+  std::map<std::string, size_t> calls;
+  url_loader_factory_.SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        url_loader_factory_.ClearResponses();
+        base::StringPiece request_string(request.request_body->elements()
+                                             ->at(0)
+                                             .As<network::DataElementBytes>()
+                                             .AsStringPiece());
+        absl::optional<base::Value> request_value =
+            base::JSONReader::Read(request_string);
+        std::string* method = request_value->FindStringKey("method");
+        ASSERT_TRUE(method);
+        ++calls[*method];
+        if (*method == "getLatestBlockhash") {
+          url_loader_factory_.AddResponse(
+              request.url.spec(),
+              "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":"
+              "{\"context\":{\"slot\":1069},\"value\":{\"blockhash\":\"" +
+                  latest_blockhash1_ + "\", \"lastValidBlockHeight\":3090}}}");
+        } else {
+          url_loader_factory_.AddResponse(request.url.spec(), "",
+                                          net::HTTP_REQUEST_TIMEOUT);
+        }
+      }));
+
+  // Signatures are sent 256 at a time, updates requested while those are in
+  // flight are folded into one more round.
+  solana_tx_manager()->UpdatePendingTransactions();
+  solana_tx_manager()->UpdatePendingTransactions();
+  solana_tx_manager()->UpdatePendingTransactions();
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(calls["getSignatureStatuses"], 4u);
+  EXPECT_TRUE(solana_tx_manager()->GetSolanaBlockTracker()->IsRunning());
+
+  // Each block tracker tick takes one blockhash and one status round.
+  calls.clear();
+  task_environment_.FastForwardBy(
+      base::Seconds(kBlockTrackerDefaultTimeInSeconds));
+  EXPECT_EQ(calls["getLatestBlockhash"], 1u);
+  EXPECT_EQ(calls["getSignatureStatuses"], 2u);
+}
+
+// A signature status that didn't change since the last poll neither rewrites
+// the transactions pref nor notifies the observers.
+TEST_F(SolanaTxManagerUnitTest, UnchangedSignatureStatusIsNotRewritten) {
+  solana_tx_manager()->GetSolanaBlockTracker()->Stop();
+  std::string from_account = "BrG44HdsEhzapvs8bEqzvkq4egwevS3fRE6ze2ENo6S8";
+  std::string to_account = "JDqrvDz8d8tFCADashbUKQDKfJZFobNy13ugN65t1wvV";
+  auto solana_tx_data = mojom::SolanaTxData::New(
+      "" /* recent_blockhash */, from_account, to_account,
+      "" /* spl_token_mint_address */, 10000000u /* lamport */, 0 /* amount */,
+      mojom::TransactionType::SolanaSystemTransfer,
+      std::vector<mojom::SolanaInstructionPtr>());
+  SolanaTxMeta meta(
+      SolanaTransaction::FromSolanaTxData(std::move(solana_tx_data)));
+  meta.set_id(TxMeta::GenerateMetaID());
+  meta.set_from(from_account);
+  meta.set_status(mojom::TransactionStatus::Submitted);
+  meta.set_tx_hash(tx_hash1_);
+  SolanaTxStateManager* tx_state_manager =
+      solana_tx_manager()->GetSolanaTxStateManager();
+  tx_state_manager->AddOrUpdateTx(meta);
+
+  TestTxStateManagerObserver observer;
+  tx_state_manager->AddObserver(&observer);
+  size_t pref_writes = 0;
+  PrefChangeRegistrar registrar;
+  registrar.Init(&prefs_);
+  registrar.Add(kBraveWalletTransactions,
+                base::BindLambdaForTesting([&]() { ++pref_writes; }));
+
+  const std::vector<std::string> tx_meta_ids = {meta.id()};
+  const std::vector<absl::optional<SolanaSignatureStatus>> confirmed = {
+      SolanaSignatureStatus(100u, 10u, "", "confirmed")};
+  solana_tx_manager()->UpdateSignatureStatuses(tx_meta_ids, confirmed);
+  EXPECT_EQ(observer.status_changed_count(), 1u);
+  EXPECT_EQ(pref_writes, 1u);
+
+  // The next poll returns the same status.
+  solana_tx_manager()->UpdateSignatureStatuses(tx_meta_ids, confirmed);
+  EXPECT_EQ(observer.status_changed_count(), 1u);
+  EXPECT_EQ(pref_writes, 1u);
+
+  solana_tx_manager()->UpdateSignatureStatuses(
+      tx_meta_ids, {SolanaSignatureStatus(72u, 0u, "", "finalized")});
+  EXPECT_EQ(observer.status_changed_count(), 2u);
+  EXPECT_EQ(pref_writes, 2u);
+  EXPECT_EQ(solana_tx_manager()->GetTxForTesting(meta.id())->status(),
+            mojom::TransactionStatus::Confirmed);
+
+  tx_state_manager->RemoveObserver(&observer);
+}
+
+// Counts the requests sent to track transactions per hour while the wallet is
+// idle, while a transaction is pending and once the wallet is locked.
+TEST_F(SolanaTxManagerUnitTest, BlockTrackerRequestsPerHour) {
+  SetInterceptor(latest_blockhash1_, tx_hash1_, "", true);
+  SolanaBlockTracker* tracker = solana_tx_manager()->GetSolanaBlockTracker();
+  solana_tx_manager()->UpdatePendingTransactions();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(tracker->IsRunning());
+
+  size_t request_count = intercepted_request_count_;
+  task_environment_.FastForwardBy(base::Hours(1));
+  const size_t idle_requests = intercepted_request_count_ - request_count;
+
+  auto solana_tx_data = mojom::SolanaTxData::New(
+      "" /* recent_blockhash */, "BrG44HdsEhzapvs8bEqzvkq4egwevS3fRE6ze2ENo6S8",
+      "JDqrvDz8d8tFCADashbUKQDKfJZFobNy13ugN65t1wvV",
+      "" /* spl_token_mint_address */, 10000000u /* lamport */, 0 /* amount */,
+      mojom::TransactionType::SolanaSystemTransfer,
+      std::vector<mojom::SolanaInstructionPtr>());
+  SolanaTxMeta meta(
+      SolanaTransaction::FromSolanaTxData(std::move(solana_tx_data)));
+  meta.set_id(TxMeta::GenerateMetaID());
+  meta.set_from("BrG44HdsEhzapvs8bEqzvkq4egwevS3fRE6ze2ENo6S8");
+  meta.set_status(mojom::TransactionStatus::Unapproved);
+  solana_tx_manager()->GetSolanaTxStateManager()->AddOrUpdateTx(meta);
+  // As ApproveTransaction does once the transaction is sent.
+  meta.set_status(mojom::TransactionStatus::Submitted);
+  meta.set_tx_hash(tx_hash1_);
+  solana_tx_manager()->GetSolanaTxStateManager()->AddOrUpdateTx(meta);
+  EXPECT_TRUE(tracker->IsRunning());
+
+  // Each tick polls the blockhash and the signature status of the pending
+  // transaction, which stays pending as its status doesn't parse.
+  request_count = intercepted_request_count_;
+  task_environment_.FastForwardBy(base::Hours(1));
+  const size_t active_requests = intercepted_request_count_ - request_count;
+
+  keyring_service_->Lock();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(tracker->IsRunning());
+  request_count = intercepted_request_count_;
+  task_environment_.FastForwardBy(base::Hours(1));
+  const size_t locked_requests = intercepted_request_count_ - request_count;
+
+  VLOG(1) << "Transaction tracking requests per hour, idle: " << idle_requests
+          << ", pending tx: " << active_requests
+          << ", locked: " << locked_requests;
+  EXPECT_EQ(idle_requests, 0u);
+  EXPECT_EQ(active_requests,
+            static_cast<size_t>(2 * 3600 / kBlockTrackerDefaultTimeInSeconds));
+  EXPECT_EQ(locked_requests, 0u);
+}
+
+// Without pending transactions the blockhash is still polled while balances
+// are read, so that the reads can be served from the response cache.
+TEST_F(SolanaTxManagerUnitTest, BlockTrackerRunsWhileCacheIsRead) {
+  size_t balance_requests = 0;
+  url_loader_factory_.SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        url_loader_factory_.ClearResponses();
+        base::StringPiece request_string(request.request_body->elements()
+                                             ->at(0)
+                                             .As<network::DataElementBytes>()
+                                             .AsStringPiece());
+        std::string result;
+        if (request_string.find("getLatestBlockhash") != std::string::npos) {
+          result = "{\"context\":{\"slot\":1069},\"value\":{\"blockhash\":\"" +
+                   latest_blockhash1_ + "\", \"lastValidBlockHeight\":3090}}";
+        } else if (request_string.find("getBalance") != std::string::npos) {
+          ++balance_requests;
+          result = "{\"context\":{\"slot\":106921266},\"value\":513234116063}";
+        }
+        url_loader_factory_.AddResponse(
+            request.url.spec(),
+            "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":" + result + "}");
+      }));
+  auto get_balance = [&]() {
+    json_rpc_service_->GetSolanaBalance(
+        "BrG44HdsEhzapvs8bEqzvkq4egwevS3fRE6ze2ENo6S8", mojom::kSolanaMainnet,
+        base::BindLambdaForTesting([](uint64_t balance,
+                                      mojom::SolanaProviderError error,
+                                      const std::string& error_message) {
+          EXPECT_EQ(error, mojom::SolanaProviderError::kSuccess);
+          EXPECT_EQ(balance, 513234116063ULL);
+        }));
+    task_environment_.RunUntilIdle();
+  };
+
+  SolanaBlockTracker* tracker = solana_tx_manager()->GetSolanaBlockTracker();
+  solana_tx_manager()->UpdatePendingTransactions();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(tracker->IsRunning());
+
+  // The first read finds no recent blockhash and starts the tracker.
+  get_balance();
+  EXPECT_EQ(balance_requests, 1u);
+  EXPECT_TRUE(tracker->IsRunning());
+
+  // Once the tracker polled the blockhash, the same read is only sent once.
+  task_environment_.FastForwardBy(
+      base::Seconds(kBlockTrackerDefaultTimeInSeconds));
+  get_balance();
+  get_balance();
+  EXPECT_EQ(balance_requests, 2u);
+
+  // The tracker stops a while after the last read.
+  task_environment_.FastForwardBy(base::Minutes(2));
+  EXPECT_FALSE(tracker->IsRunning());
+}
+
 TEST_F(SolanaTxManagerUnitTest, MakeSystemProgramTransferTxData) {
   std::string from_account = "BrG44HdsEhzapvs8bEqzvkq4egwevS3fRE6ze2ENo6S8";
   std::string to_account = "JDqrvDz8d8tFCADashbUKQDKfJZFobNy13ugN65t1wvV";
@@ -223,7 +223,9 @@ void SwapService::GetPriceQuote(mojom::SwapParamsPtr swap_params,
       "GET",
       GetPriceQuoteURL(std::move(swap_params),
                        json_rpc_service_->GetChainId(mojom::CoinType::ETH)),
-      "", "", true, std::move(internal_callback));
+      "", "", true, std::move(internal_callback), {}, -1u,
+      base::NullCallback(),
+      api_request_helper::APIRequestHelper::Priority::kInteractive);
 }
 
 void SwapService::OnGetPriceQuote(
@@ -261,7 +263,9 @@ void SwapService::GetTransactionPayload(
       GetTransactionPayloadURL(
           std::move(swap_params),
           json_rpc_service_->GetChainId(mojom::CoinType::ETH)),
-      "", "", true, std::move(internal_callback));
+      "", "", true, std::move(internal_callback), {}, -1u,
+      base::NullCallback(),
+      api_request_helper::APIRequestHelper::Priority::kInteractive);
 }
 
 void SwapService::OnGetTransactionPayload(
@@ -9,17 +9,20 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/check.h"
 #include "base/logging.h"
 #include "brave/components/brave_wallet/browser/block_tracker.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
+#include "brave/components/brave_wallet/browser/json_rpc_service.h"
 #include "brave/components/brave_wallet/browser/keyring_service.h"
 #include "brave/components/brave_wallet/browser/tx_meta.h"
 #include "brave/components/brave_wallet/browser/tx_service.h"
 
 namespace brave_wallet {
 
-TxManager::TxManager(std::unique_ptr<TxStateManager> tx_state_manager,
+TxManager::TxManager(mojom::CoinType coin,
+                     std::unique_ptr<TxStateManager> tx_state_manager,
                      std::unique_ptr<BlockTracker> block_tracker,
                      TxService* tx_service,
                      JsonRpcService* json_rpc_service,
@@ -30,12 +33,16 @@ TxManager::TxManager(std::unique_ptr<TxStateManager> tx_state_manager,
       tx_service_(tx_service),
       json_rpc_service_(json_rpc_service),
       keyring_service_(keyring_service),
-      prefs_(prefs) {
+      prefs_(prefs),
+      coin_(coin) {
   DCHECK(tx_service_);
   DCHECK(json_rpc_service_);
   DCHECK(keyring_service_);
 
   CheckIfBlockTrackerShouldRun();
+  cached_read_without_block_subscription_ =
+      json_rpc_service_->AddCachedReadWithoutBlockCallback(base::BindRepeating(
+          &TxManager::OnCachedReadWithoutBlock, base::Unretained(this)));
   tx_state_manager_->AddObserver(this);
   keyring_service_->AddObserver(
       keyring_observer_receiver_.BindNewPipeAndPassRemote());
@@ -91,19 +98,35 @@ void TxManager::RejectTransaction(const std::string& tx_meta_id,
 }
 
 void TxManager::CheckIfBlockTrackerShouldRun() {
-  bool locked = keyring_service_->IsLocked();
+  // Poll while there may be submitted transactions to track, or while the
+  // response cache of the network is read so that it has a recent block. The
+  // tracker is started again when a transaction is submitted, a read finds
+  // no recent block or the wallet unlocks.
+  bool should_run = !keyring_service_->IsLocked() &&
+                    (!known_no_pending_tx_ ||
+                     json_rpc_service_->HasRecentCachedReads(coin_));
   bool running = block_tracker_->IsRunning();
-  if (!locked && !running) {
+  if (should_run && !running) {
     block_tracker_->Start(base::Seconds(kBlockTrackerDefaultTimeInSeconds));
-  } else if ((locked || known_no_pending_tx_) && running) {
+  } else if (!should_run && running) {
     block_tracker_->Stop();
   }
 }
 
 void TxManager::OnTransactionStatusChanged(mojom::TransactionInfoPtr tx_info) {
+  if (tx_info->tx_status == mojom::TransactionStatus::Submitted &&
+      known_no_pending_tx_) {
+    known_no_pending_tx_ = false;
+    CheckIfBlockTrackerShouldRun();
+  }
   tx_service_->OnTransactionStatusChanged(tx_info->Clone());
 }
 
+void TxManager::OnCachedReadWithoutBlock(mojom::CoinType coin) {
+  if (coin == coin_)
+    CheckIfBlockTrackerShouldRun();
+}
+
 void TxManager::OnNewUnapprovedTx(mojom::TransactionInfoPtr tx_info) {
   tx_service_->OnNewUnapprovedTx(tx_info->Clone());
 }
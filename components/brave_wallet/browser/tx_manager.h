@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 
+#include "base/callback_list.h"
 #include "brave/components/brave_wallet/browser/tx_state_manager.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "mojo/public/cpp/bindings/receiver.h"
@@ -25,7 +26,8 @@ class TxService;
 class TxManager : public TxStateManager::Observer,
                   public mojom::KeyringServiceObserver {
  public:
-  TxManager(std::unique_ptr<TxStateManager> tx_state_manager,
+  TxManager(mojom::CoinType coin,
+            std::unique_ptr<TxStateManager> tx_state_manager,
             std::unique_ptr<BlockTracker> block_tracker,
             TxService* tx_service,
             JsonRpcService* json_rpc_service,
@@ -86,6 +88,8 @@ class TxManager : public TxStateManager::Observer,
   bool known_no_pending_tx_ = false;
 
  private:
+  void OnCachedReadWithoutBlock(mojom::CoinType coin);
+
   // TxStateManager::Observer
   void OnTransactionStatusChanged(mojom::TransactionInfoPtr tx_info) override;
   void OnNewUnapprovedTx(mojom::TransactionInfoPtr tx_info) override;
@@ -101,6 +105,8 @@ class TxManager : public TxStateManager::Observer,
   void AutoLockMinutesChanged() override {}
   void SelectedAccountChanged(mojom::CoinType coin) override {}
 
+  const mojom::CoinType coin_;
+  base::CallbackListSubscription cached_read_without_block_subscription_;
   mojo::Receiver<brave_wallet::mojom::KeyringServiceObserver>
       keyring_observer_receiver_{this};
 };
@@ -5,8 +5,11 @@
 
 #include "brave/components/brave_wallet/browser/tx_state_manager.h"
 
+#include <map>
 #include <utility>
 
+#include "base/auto_reset.h"
+#include "base/bind.h"
 #include "base/json/values_util.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
@@ -74,21 +77,85 @@ bool TxStateManager::ValueToTxMeta(const base::Value& value, TxMeta* meta) {
   return true;
 }
 
+TxStateManager::TxIndex::TxIndex() = default;
+TxStateManager::TxIndex::~TxIndex() = default;
+TxStateManager::TxIndex::TxIndex(TxIndex&&) = default;
+TxStateManager::TxIndex& TxStateManager::TxIndex::operator=(TxIndex&&) =
+    default;
+
+void TxStateManager::TxIndex::Add(const std::string& id,
+                                  mojom::TransactionStatus status,
+                                  const std::string& from) {
+  Remove(id);
+  entries[id] = std::make_pair(status, from);
+  ids_by_status[status].insert(id);
+  ids_by_from[from].insert(id);
+}
+
+void TxStateManager::TxIndex::Remove(const std::string& id) {
+  auto it = entries.find(id);
+  if (it == entries.end())
+    return;
+  auto status_it = ids_by_status.find(it->second.first);
+  status_it->second.erase(id);
+  if (status_it->second.empty())
+    ids_by_status.erase(status_it);
+  auto from_it = ids_by_from.find(it->second.second);
+  from_it->second.erase(id);
+  if (from_it->second.empty())
+    ids_by_from.erase(from_it);
+  entries.erase(it);
+}
+
+bool TxStateManager::TxIndex::Matches(const base::Value& network_dict) const {
+  size_t count = 0;
+  for (const auto item : network_dict.DictItems()) {
+    absl::optional<int> status = item.second.FindIntKey("status");
+    const std::string* from = item.second.FindStringKey("from");
+    if (!status || !from)
+      continue;
+    auto it = entries.find(item.first);
+    if (it == entries.end() ||
+        it->second.first != static_cast<mojom::TransactionStatus>(*status) ||
+        it->second.second != *from) {
+      return false;
+    }
+    ++count;
+  }
+  return count == entries.size();
+}
+
 TxStateManager::TxStateManager(PrefService* prefs,
                                JsonRpcService* json_rpc_service)
     : prefs_(prefs), json_rpc_service_(json_rpc_service), weak_factory_(this) {
   DCHECK(json_rpc_service_);
+  pref_change_registrar_.Init(prefs_);
+  pref_change_registrar_.Add(
+      kBraveWalletTransactions,
+      base::BindRepeating(&TxStateManager::OnTransactionsPrefChanged,
+                          weak_factory_.GetWeakPtr()));
 }
 
 TxStateManager::~TxStateManager() = default;
 
 void TxStateManager::AddOrUpdateTx(const TxMeta& meta) {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::Value* dict = update.Get();
-  const std::string path = GetTxPrefPathPrefix() + "." + meta.id();
+  const std::string prefix = GetTxPrefPathPrefix();
+  const std::string path = prefix + "." + meta.id();
+  base::Value value = meta.ToValue();
+  const base::Value* stored_value =
+      prefs_->GetDictionary(kBraveWalletTransactions)->FindPath(path);
+  const bool is_add = stored_value == nullptr;
+  // Every pref write serializes the whole transactions pref again, skip it
+  // when nothing changed.
+  if (is_add || *stored_value != value) {
+    base::AutoReset<bool> updating_prefs(&updating_prefs_, true);
+    DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
+    update.Get()->SetPath(path, std::move(value));
+  }
+  auto index_it = tx_indexes_.find(prefix);
+  if (index_it != tx_indexes_.end())
+    index_it->second.Add(meta.id(), meta.status(), meta.from());
 
-  bool is_add = dict->FindPath(path) == nullptr;
-  dict->SetPath(path, meta.ToValue());
   if (!is_add) {
     for (auto& observer : observers_)
       observer.OnTransactionStatusChanged(meta.ToTransactionInfo());
@@ -115,40 +182,142 @@ std::unique_ptr<TxMeta> TxStateManager::GetTx(const std::string& id) {
 }
 
 void TxStateManager::DeleteTx(const std::string& id) {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::Value* dict = update.Get();
-  dict->RemovePath(GetTxPrefPathPrefix() + "." + id);
+  const std::string prefix = GetTxPrefPathPrefix();
+  {
+    base::AutoReset<bool> updating_prefs(&updating_prefs_, true);
+    DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
+    base::Value* dict = update.Get();
+    dict->RemovePath(prefix + "." + id);
+  }
+  auto index_it = tx_indexes_.find(prefix);
+  if (index_it != tx_indexes_.end())
+    index_it->second.Remove(id);
 }
 
 void TxStateManager::WipeTxs() {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::Value* dict = update.Get();
-  dict->RemovePath(GetTxPrefPathPrefix());
+  const std::string prefix = GetTxPrefPathPrefix();
+  {
+    base::AutoReset<bool> updating_prefs(&updating_prefs_, true);
+    DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
+    base::Value* dict = update.Get();
+    dict->RemovePath(prefix);
+  }
+  tx_indexes_.erase(prefix);
 }
 
 std::vector<std::unique_ptr<TxMeta>> TxStateManager::GetTransactionsByStatus(
     absl::optional<mojom::TransactionStatus> status,
     absl::optional<std::string> from) {
   std::vector<std::unique_ptr<TxMeta>> result;
+  const std::string prefix = GetTxPrefPathPrefix();
   const base::Value* dict = prefs_->GetDictionary(kBraveWalletTransactions);
-  const base::Value* network_dict = dict->FindPath(GetTxPrefPathPrefix());
+  const base::Value* network_dict = dict->FindPath(prefix);
   if (!network_dict)
     return result;
 
-  for (const auto it : network_dict->DictItems()) {
-    std::unique_ptr<TxMeta> meta = ValueToTxMeta(it.second);
-    if (!meta) {
-      continue;
-    }
-    if (!status.has_value() || meta->status() == *status) {
-      if (from.has_value() && meta->from() != *from)
-        continue;
+  const TxIndex& index = GetTxIndex(prefix, *network_dict);
+  auto add_tx = [&](const std::string& id) {
+    const base::Value* value = network_dict->FindKey(id);
+    if (!value)
+      return;
+    std::unique_ptr<TxMeta> meta = ValueToTxMeta(*value);
+    if (meta)
       result.push_back(std::move(meta));
+  };
+
+  // Walk the narrowest candidate set, ids are visited in sorted order like
+  // the pref dictionary itself.
+  const base::flat_set<std::string>* ids_with_status = nullptr;
+  if (status) {
+    auto it = index.ids_by_status.find(*status);
+    if (it == index.ids_by_status.end())
+      return result;
+    ids_with_status = &it->second;
+  }
+  const base::flat_set<std::string>* ids_from = nullptr;
+  if (from) {
+    auto it = index.ids_by_from.find(*from);
+    if (it == index.ids_by_from.end())
+      return result;
+    ids_from = &it->second;
+  }
+
+  if (ids_with_status && ids_from) {
+    const bool status_is_smaller = ids_with_status->size() < ids_from->size();
+    const auto& candidates = status_is_smaller ? *ids_with_status : *ids_from;
+    const auto& other = status_is_smaller ? *ids_from : *ids_with_status;
+    for (const auto& id : candidates) {
+      if (other.contains(id))
+        add_tx(id);
     }
+  } else if (ids_with_status || ids_from) {
+    for (const auto& id : ids_with_status ? *ids_with_status : *ids_from)
+      add_tx(id);
+  } else {
+    for (const auto& entry : index.entries)
+      add_tx(entry.first);
   }
   return result;
 }
 
+TxStateManager::TxIndex& TxStateManager::GetTxIndex(
+    const std::string& prefix,
+    const base::Value& network_dict) {
+  auto it = tx_indexes_.find(prefix);
+  if (it != tx_indexes_.end())
+    return it->second;
+
+  // Collect everything first, inserting into flat containers one by one
+  // would be quadratic for long histories.
+  std::vector<std::pair<std::string,
+                        std::pair<mojom::TransactionStatus, std::string>>>
+      entries;
+  std::map<mojom::TransactionStatus, std::vector<std::string>> ids_by_status;
+  std::map<std::string, std::vector<std::string>> ids_by_from;
+  for (const auto item : network_dict.DictItems()) {
+    absl::optional<int> status = item.second.FindIntKey("status");
+    const std::string* from = item.second.FindStringKey("from");
+    if (!status || !from)
+      continue;
+    auto tx_status = static_cast<mojom::TransactionStatus>(*status);
+    entries.emplace_back(item.first, std::make_pair(tx_status, *from));
+    ids_by_status[tx_status].push_back(item.first);
+    ids_by_from[*from].push_back(item.first);
+  }
+
+  TxIndex& index = tx_indexes_[prefix];
+  index.entries = base::flat_map<
+      std::string, std::pair<mojom::TransactionStatus, std::string>>(
+      std::move(entries));
+  std::vector<std::pair<mojom::TransactionStatus, base::flat_set<std::string>>>
+      status_sets;
+  for (auto& ids : ids_by_status)
+    status_sets.emplace_back(ids.first, std::move(ids.second));
+  index.ids_by_status = base::flat_map<mojom::TransactionStatus,
+                                       base::flat_set<std::string>>(
+      std::move(status_sets));
+  std::vector<std::pair<std::string, base::flat_set<std::string>>> from_sets;
+  for (auto& ids : ids_by_from)
+    from_sets.emplace_back(ids.first, std::move(ids.second));
+  index.ids_by_from =
+      base::flat_map<std::string, base::flat_set<std::string>>(
+          std::move(from_sets));
+  return index;
+}
+
+void TxStateManager::OnTransactionsPrefChanged() {
+  // Our own writes keep the index up to date.
+  if (updating_prefs_)
+    return;
+  // All coins share the transactions pref. Only drop the indexes whose
+  // networks changed, writes by the other managers usually don't touch them.
+  const base::Value* dict = prefs_->GetDictionary(kBraveWalletTransactions);
+  base::EraseIf(tx_indexes_, [dict](const auto& item) {
+    const base::Value* network_dict = dict->FindPath(item.first);
+    return !network_dict || !item.second.Matches(*network_dict);
+  });
+}
+
 void TxStateManager::RetireTxByStatus(mojom::TransactionStatus status,
                                       size_t max_num) {
   if (status != mojom::TransactionStatus::Confirmed &&
@@ -8,14 +8,18 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 class PrefService;
@@ -63,7 +67,39 @@ class TxStateManager {
 
  private:
   FRIEND_TEST_ALL_PREFIXES(TxStateManagerUnitTest, TxOperations);
+  FRIEND_TEST_ALL_PREFIXES(TxStateManagerUnitTest,
+                           IndexSurvivesOtherNetworkWrites);
+
+  // Status and from address of every transaction stored under one pref path
+  // prefix, so lookups only deserialize the transactions they return.
+  struct TxIndex {
+    TxIndex();
+    ~TxIndex();
+    TxIndex(TxIndex&&);
+    TxIndex& operator=(TxIndex&&);
+
+    void Add(const std::string& id,
+             mojom::TransactionStatus status,
+             const std::string& from);
+    void Remove(const std::string& id);
+    // Whether the status and from address of every transaction in
+    // |network_dict| are still the indexed ones.
+    bool Matches(const base::Value& network_dict) const;
+
+    // <id, <status, from>>
+    base::flat_map<std::string,
+                   std::pair<mojom::TransactionStatus, std::string>>
+        entries;
+    base::flat_map<mojom::TransactionStatus, base::flat_set<std::string>>
+        ids_by_status;
+    base::flat_map<std::string, base::flat_set<std::string>> ids_by_from;
+  };
+
   void RetireTxByStatus(mojom::TransactionStatus status, size_t max_num);
+  // Builds the index of |prefix| from |network_dict| on first use.
+  TxIndex& GetTxIndex(const std::string& prefix,
+                      const base::Value& network_dict);
+  void OnTransactionsPrefChanged();
 
   // Each derived class should implement its own ValueToTxMeta to create a
   // specific type of tx meta (ex: EthTxMeta) from a value. TxMeta
@@ -78,6 +114,13 @@ class TxStateManager {
 
   base::ObserverList<Observer> observers_;
 
+  // <pref path prefix, index>
+  base::flat_map<std::string, TxIndex> tx_indexes_;
+  PrefChangeRegistrar pref_change_registrar_;
+  // Set while we write the transactions pref so our own writes do not drop
+  // the indexes.
+  bool updating_prefs_ = false;
+
   base::WeakPtrFactory<TxStateManager> weak_factory_;
 };
 
@@ -6,9 +6,11 @@
 #include "brave/components/brave_wallet/browser/tx_state_manager.h"
 
 #include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
 #include "base/test/bind.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
@@ -16,8 +18,11 @@
 #include "brave/components/brave_wallet/browser/eth_tx_state_manager.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
+#include "brave/components/brave_wallet/browser/solana_tx_state_manager.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "components/prefs/pref_service.h"
+#include "components/prefs/scoped_user_pref_update.h"
 #include "components/sync_preferences/testing_pref_service_syncable.h"
 #include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
 #include "services/network/test/test_url_loader_factory.h"
@@ -279,6 +284,145 @@ TEST_F(TxStateManagerUnitTest, GetTransactionsByStatus) {
   }
 }
 
+TEST_F(TxStateManagerUnitTest, IndexFollowsUpdates) {
+  prefs_.ClearPref(kBraveWalletTransactions);
+  const std::string addr1 = "0x3535353535353535353535353535353535353535";
+  const std::string addr2 = "0x2f015c60e0be116b1f0cd534704db9c92118fb6a";
+
+  EthTxMeta meta;
+  meta.set_id("001");
+  meta.set_from(addr1);
+  meta.set_status(mojom::TransactionStatus::Submitted);
+  tx_state_manager_->AddOrUpdateTx(meta);
+  // Builds the index.
+  EXPECT_EQ(tx_state_manager_
+                ->GetTransactionsByStatus(mojom::TransactionStatus::Submitted,
+                                          addr1)
+                .size(),
+            1u);
+
+  meta.set_status(mojom::TransactionStatus::Confirmed);
+  tx_state_manager_->AddOrUpdateTx(meta);
+  EXPECT_TRUE(tx_state_manager_
+                  ->GetTransactionsByStatus(
+                      mojom::TransactionStatus::Submitted, absl::nullopt)
+                  .empty());
+  auto confirmed = tx_state_manager_->GetTransactionsByStatus(
+      mojom::TransactionStatus::Confirmed, addr1);
+  ASSERT_EQ(confirmed.size(), 1u);
+  EXPECT_EQ(confirmed[0]->id(), "001");
+
+  tx_state_manager_->DeleteTx("001");
+  EXPECT_TRUE(
+      tx_state_manager_->GetTransactionsByStatus(absl::nullopt, addr1).empty());
+
+  // Transactions written to the pref by someone else, e.g. by a migration,
+  // are picked up.
+  meta.set_id("002");
+  meta.set_from(addr2);
+  {
+    DictionaryPrefUpdate update(&prefs_, kBraveWalletTransactions);
+    update->SetPath("ethereum.mainnet.002", meta.ToValue());
+  }
+  EXPECT_EQ(
+      tx_state_manager_->GetTransactionsByStatus(absl::nullopt, addr2).size(),
+      1u);
+
+  prefs_.ClearPref(kBraveWalletTransactions);
+  EXPECT_TRUE(
+      tx_state_manager_->GetTransactionsByStatus(absl::nullopt, addr2).empty());
+}
+
+// All coins share the transactions pref, writes for another network keep
+// the index while writes for the same network drop it.
+TEST_F(TxStateManagerUnitTest, IndexSurvivesOtherNetworkWrites) {
+  prefs_.ClearPref(kBraveWalletTransactions);
+  const std::string addr = "0x3535353535353535353535353535353535353535";
+  EthTxMeta meta;
+  meta.set_id("001");
+  meta.set_from(addr);
+  meta.set_status(mojom::TransactionStatus::Submitted);
+  tx_state_manager_->AddOrUpdateTx(meta);
+  tx_state_manager_->GetTransactionsByStatus(absl::nullopt, absl::nullopt);
+  EXPECT_EQ(tx_state_manager_->tx_indexes_.size(), 1u);
+
+  SolanaTxStateManager solana_tx_state_manager(&prefs_,
+                                               json_rpc_service_.get());
+  solana_tx_state_manager.DeleteTx("002");
+  EXPECT_EQ(tx_state_manager_->tx_indexes_.size(), 1u);
+
+  // Outside writes that keep the indexed fields keep the index.
+  {
+    DictionaryPrefUpdate update(&prefs_, kBraveWalletTransactions);
+    update->SetStringPath("ethereum.mainnet.001.tx_hash", "0x1");
+  }
+  EXPECT_EQ(tx_state_manager_->tx_indexes_.size(), 1u);
+  {
+    DictionaryPrefUpdate update(&prefs_, kBraveWalletTransactions);
+    update->SetIntPath("ethereum.mainnet.001.status",
+                       static_cast<int>(mojom::TransactionStatus::Confirmed));
+  }
+  EXPECT_TRUE(tx_state_manager_->tx_indexes_.empty());
+  EXPECT_EQ(tx_state_manager_
+                ->GetTransactionsByStatus(mojom::TransactionStatus::Confirmed,
+                                          absl::nullopt)
+                .size(),
+            1u);
+  meta.set_status(mojom::TransactionStatus::Confirmed);
+
+  EthTxStateManager other_eth_tx_state_manager(&prefs_,
+                                               json_rpc_service_.get());
+  meta.set_id("003");
+  other_eth_tx_state_manager.AddOrUpdateTx(meta);
+  EXPECT_TRUE(tx_state_manager_->tx_indexes_.empty());
+  EXPECT_EQ(
+      tx_state_manager_->GetTransactionsByStatus(absl::nullopt, addr).size(),
+      2u);
+}
+
+TEST_F(TxStateManagerUnitTest, GetTransactionsByStatusLongHistory) {
+  prefs_.ClearPref(kBraveWalletTransactions);
+  constexpr size_t kTxCount = 10000;
+  constexpr size_t kAccountCount = 100;
+  {
+    DictionaryPrefUpdate update(&prefs_, kBraveWalletTransactions);
+    for (size_t i = 0; i < kTxCount; ++i) {
+      EthTxMeta meta;
+      meta.set_id(base::NumberToString(i));
+      meta.set_from(base::StringPrintf("0x%040zx", i % kAccountCount));
+      // A handful of pending transactions among a long dropped/error history.
+      meta.set_status(i % 1000 == 0 ? mojom::TransactionStatus::Submitted
+                                    : mojom::TransactionStatus::Error);
+      update->SetPath("ethereum.mainnet." + meta.id(), meta.ToValue());
+    }
+  }
+
+  base::ElapsedTimer first_lookup_timer;
+  EXPECT_EQ(tx_state_manager_
+                ->GetTransactionsByStatus(mojom::TransactionStatus::Submitted,
+                                          absl::nullopt)
+                .size(),
+            kTxCount / 1000);
+  const base::TimeDelta first_lookup = first_lookup_timer.Elapsed();
+
+  base::ElapsedTimer lookups_timer;
+  for (size_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(tx_state_manager_
+                  ->GetTransactionsByStatus(
+                      mojom::TransactionStatus::Submitted, absl::nullopt)
+                  .size(),
+              kTxCount / 1000);
+  }
+  const std::string from = base::StringPrintf("0x%040zx", size_t{1});
+  EXPECT_EQ(
+      tx_state_manager_
+          ->GetTransactionsByStatus(mojom::TransactionStatus::Error, from)
+          .size(),
+      kTxCount / kAccountCount);
+  VLOG(1) << "First lookup, including index build: " << first_lookup
+          << ", 100 indexed lookups: " << lookups_timer.Elapsed();
+}
+
 TEST_F(TxStateManagerUnitTest, SwitchNetwork) {
   prefs_.ClearPref(kBraveWalletTransactions);
 
@@ -387,4 +531,30 @@ TEST_F(TxStateManagerUnitTest, Observer) {
   observer.Reset();
 }
 
+TEST_F(TxStateManagerUnitTest, SkipsUnchangedWrites) {
+  size_t pref_writes = 0;
+  PrefChangeRegistrar pref_change_registrar;
+  pref_change_registrar.Init(&prefs_);
+  pref_change_registrar.Add(
+      kBraveWalletTransactions,
+      base::BindLambdaForTesting([&](const std::string&) { ++pref_writes; }));
+  TestTxStateManagerObserver observer;
+  tx_state_manager_->AddObserver(&observer);
+
+  EthTxMeta meta;
+  meta.set_id("001");
+  tx_state_manager_->AddOrUpdateTx(meta);
+  EXPECT_EQ(pref_writes, 1u);
+
+  // Observers are still told about the update.
+  tx_state_manager_->AddOrUpdateTx(meta);
+  EXPECT_EQ(pref_writes, 1u);
+  EXPECT_TRUE(observer.TxStatusChangedFired());
+
+  meta.set_status(mojom::TransactionStatus::Approved);
+  tx_state_manager_->AddOrUpdateTx(meta);
+  EXPECT_EQ(pref_writes, 2u);
+  tx_state_manager_->RemoveObserver(&observer);
+}
+
 }  // namespace brave_wallet
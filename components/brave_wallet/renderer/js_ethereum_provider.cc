@@ -13,6 +13,7 @@
 #include "base/json/json_writer.h"
 #include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/components/brave_wallet/common/brave_wallet_response_helpers.h"
 #include "brave/components/brave_wallet/common/eth_request_helper.h"
 #include "brave/components/brave_wallet/common/hex_utils.h"
@@ -532,7 +533,9 @@ void JSEthereumProvider::InjectInitScript(bool allow_overwrite_window_ethereum,
     SetProviderNonWritable(web_frame, "ethereum");
   }
   if (is_main_world) {
-    ExecuteScript(web_frame, *g_provider_script);
+    TRACE_EVENT0("brave", "InjectEthereumProvider");
+    ExecuteCachedScript(web_frame, "brave-wallet-ethereum-provider",
+                        *g_provider_script);
   }
 }
 
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/no_destructor.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/components/brave_wallet/common/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/common/brave_wallet_response_helpers.h"
 #include "brave/components/brave_wallet/common/solana_utils.h"
@@ -175,7 +176,9 @@ void JSSolanaProvider::InjectInitScript(bool allow_overwrite_window_solana,
     SetProviderNonWritable(web_frame, "solana");
   }
   if (is_main_world) {
-    ExecuteScript(web_frame, *g_provider_script);
+    TRACE_EVENT0("brave", "InjectSolanaProvider");
+    ExecuteCachedScript(web_frame, "brave-wallet-solana-provider",
+                        *g_provider_script);
   }
 }
 
@@ -8,14 +8,33 @@
 #include <utility>
 
 #include "base/strings/stringprintf.h"
+#include "brave/components/script_cache/renderer/script_cache.h"
 #include "gin/converter.h"
+#include "third_party/blink/public/common/web_preferences/web_preferences.h"
+#include "third_party/blink/public/platform/web_content_settings_client.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_script_source.h"
+#include "third_party/blink/public/web/web_view.h"
 #include "v8/include/v8-function.h"
 #include "v8/include/v8-microtask-queue.h"
 
 namespace brave_wallet {
 
+namespace {
+
+// The same check blink does before WebLocalFrame::ExecuteScript runs a main
+// world script, which script_cache::RunCachedScript skips.
+bool IsScriptAllowed(blink::WebLocalFrame* web_frame) {
+  const bool enabled_per_settings =
+      web_frame->View()->GetWebPreferences().javascript_enabled;
+  blink::WebContentSettingsClient* client =
+      web_frame->GetContentSettingsClient();
+  return client ? client->AllowScript(enabled_per_settings)
+                : enabled_per_settings;
+}
+
+}  // namespace
+
 v8::MaybeLocal<v8::Value> GetProperty(v8::Local<v8::Context> context,
                                       v8::Local<v8::Value> object,
                                       const std::u16string& name) {
@@ -97,6 +116,25 @@ void ExecuteScript(blink::WebLocalFrame* web_frame, const std::string script) {
       blink::WebScriptSource(blink::WebString::FromUTF8(script)));
 }
 
+void ExecuteCachedScript(blink::WebLocalFrame* web_frame,
+                         const std::string& name,
+                         const std::string& script) {
+  if (web_frame->IsProvisional())
+    return;
+
+  // When script is disabled, ExecuteScript blocks |script| and reports it.
+  if (!IsScriptAllowed(web_frame)) {
+    ExecuteScript(web_frame, script);
+    return;
+  }
+
+  v8::HandleScope handle_scope(v8::Isolate::GetCurrent());
+  if (!script_cache::RunCachedScript(
+          web_frame, web_frame->MainWorldScriptContext(), name, script)) {
+    ExecuteScript(web_frame, script);
+  }
+}
+
 void SetProviderNonWritable(blink::WebLocalFrame* web_frame,
                             const std::string& provider) {
   const char* provider_str = provider.c_str();
@@ -41,6 +41,13 @@ v8::MaybeLocal<v8::Value> CallMethodOfObject(
 
 void ExecuteScript(blink::WebLocalFrame* web_frame, const std::string script);
 
+// Runs |script| in the main world of |web_frame| like ExecuteScript, but
+// compiles it only once per renderer, see script_cache::RunCachedScript.
+// Nothing runs if script is disabled for |web_frame|.
+void ExecuteCachedScript(blink::WebLocalFrame* web_frame,
+                         const std::string& name,
+                         const std::string& script);
+
 // By default we allow extensions to overwrite the window.[provider] object
 // but if the user goes into settings and explicitly selects to use Brave Wallet
 // then we will block modifications to window.[provider] here.
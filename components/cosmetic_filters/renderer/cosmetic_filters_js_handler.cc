@@ -16,6 +16,7 @@
 #include "base/trace_event/trace_event.h"
 #include "brave/components/content_settings/renderer/brave_content_settings_agent_impl.h"
 #include "brave/components/cosmetic_filters/resources/grit/cosmetic_filters_generated_map.h"
+#include "brave/components/script_cache/renderer/script_cache.h"
 #include "components/content_settings/renderer/content_settings_agent_impl.h"
 #include "content/public/renderer/render_frame.h"
 #include "gin/arguments.h"
@@ -495,14 +496,24 @@ void CosmeticFiltersJSHandler::ExecuteObservingBundleEntryPoint() {
   DCHECK(web_frame);
 
   if (!bundle_injected_) {
+    TRACE_EVENT0("brave.adblock", "InjectObservingBundle");
     static base::NoDestructor<std::string> s_observing_script(
         LoadDataResource(kCosmeticFiltersGenerated[0].id));
     bundle_injected_ = true;
 
-    web_frame->ExecuteScriptInIsolatedWorld(
-        isolated_world_id_,
-        blink::WebScriptSource(blink::WebString::FromUTF8(*s_observing_script)),
-        blink::BackForwardCacheAware::kAllow);
+    v8::HandleScope handle_scope(blink::MainThreadIsolate());
+    v8::Local<v8::Context> context = web_frame->GetScriptContextFromWorldId(
+        blink::MainThreadIsolate(), isolated_world_id_);
+    if (context.IsEmpty() ||
+        !script_cache::RunCachedScript(web_frame, context,
+                                       "brave-cosmetic-filters-observing",
+                                       *s_observing_script)) {
+      web_frame->ExecuteScriptInIsolatedWorld(
+          isolated_world_id_,
+          blink::WebScriptSource(
+              blink::WebString::FromUTF8(*s_observing_script)),
+          blink::BackForwardCacheAware::kAllow);
+    }
 
     // kObservingScriptletEntryPoint was called by `s_observing_script`.
     return;
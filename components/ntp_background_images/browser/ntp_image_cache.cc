@@ -0,0 +1,110 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/task/thread_pool.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+absl::optional<std::string> ReadFileToString(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return absl::optional<std::string>();
+  return contents;
+}
+
+}  // namespace
+
+NTPImageCache::NTPImageCache(size_t max_bytes)
+    : max_bytes_(max_bytes), images_(decltype(images_)::NO_AUTO_EVICT) {}
+
+NTPImageCache::~NTPImageCache() = default;
+
+void NTPImageCache::GetImage(const base::FilePath& image_file,
+                             GetImageCallback callback) {
+  auto it = images_.Get(image_file);
+  if (it != images_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+
+  const bool is_reading = pending_reads_.contains(image_file);
+  pending_reads_[image_file].push_back(std::move(callback));
+  if (!is_reading)
+    ReadImage(image_file);
+}
+
+void NTPImageCache::Prefetch(const base::FilePath& image_file) {
+  if (image_file.empty() || images_.Peek(image_file) != images_.end() ||
+      pending_reads_.contains(image_file)) {
+    return;
+  }
+
+  // Tracked without callbacks so that requests made meanwhile share the read.
+  pending_reads_[image_file];
+  ReadImage(image_file);
+}
+
+void NTPImageCache::Clear() {
+  images_.Clear();
+  total_bytes_ = 0;
+}
+
+void NTPImageCache::ReadImage(const base::FilePath& image_file) {
+  ++disk_read_count_;
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ReadFileToString, image_file),
+      base::BindOnce(&NTPImageCache::OnReadImage, weak_factory_.GetWeakPtr(),
+                     image_file));
+}
+
+void NTPImageCache::OnReadImage(const base::FilePath& image_file,
+                                absl::optional<std::string> contents) {
+  std::vector<GetImageCallback> callbacks;
+  auto pending_it = pending_reads_.find(image_file);
+  if (pending_it != pending_reads_.end()) {
+    callbacks = std::move(pending_it->second);
+    pending_reads_.erase(pending_it);
+  }
+
+  scoped_refptr<base::RefCountedMemory> image;
+  if (contents) {
+    image = base::RefCountedString::TakeString(&*contents);
+    Put(image_file, image);
+  }
+
+  for (auto& callback : callbacks)
+    std::move(callback).Run(image);
+}
+
+void NTPImageCache::Put(const base::FilePath& image_file,
+                        scoped_refptr<base::RefCountedMemory> image) {
+  if (image->size() > max_bytes_)
+    return;
+
+  auto it = images_.Peek(image_file);
+  if (it != images_.end()) {
+    total_bytes_ -= it->second->size();
+    images_.Erase(it);
+  }
+
+  total_bytes_ += image->size();
+  images_.Put(image_file, std::move(image));
+  while (total_bytes_ > max_bytes_) {
+    auto oldest = images_.rbegin();
+    total_bytes_ -= oldest->second->size();
+    images_.Erase(oldest);
+  }
+}
+
+}  // namespace ntp_background_images
@@ -0,0 +1,69 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGE_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGE_CACHE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/lru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace ntp_background_images {
+
+// Keeps recently used and prefetched NTP images in memory so that opening new
+// tabs doesn't read multi-megabyte wallpapers from disk each time. Least
+// recently used images are evicted once |max_bytes| is exceeded. Concurrent
+// requests for the same file share a single disk read.
+class NTPImageCache {
+ public:
+  using GetImageCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
+  // Room for a few full resolution wallpapers.
+  static constexpr size_t kDefaultMaxBytes = 16 * 1024 * 1024;
+
+  explicit NTPImageCache(size_t max_bytes = kDefaultMaxBytes);
+  ~NTPImageCache();
+
+  NTPImageCache(const NTPImageCache&) = delete;
+  NTPImageCache& operator=(const NTPImageCache&) = delete;
+
+  // Runs |callback| with the contents of |image_file|, or with nullptr if it
+  // can't be read. Runs synchronously when the image is in memory.
+  void GetImage(const base::FilePath& image_file, GetImageCallback callback);
+  // Loads |image_file| in memory ahead of its request.
+  void Prefetch(const base::FilePath& image_file);
+  void Clear();
+
+  size_t disk_read_count() const { return disk_read_count_; }
+  size_t total_bytes() const { return total_bytes_; }
+
+ private:
+  void ReadImage(const base::FilePath& image_file);
+  void OnReadImage(const base::FilePath& image_file,
+                   absl::optional<std::string> contents);
+  void Put(const base::FilePath& image_file,
+           scoped_refptr<base::RefCountedMemory> image);
+
+  const size_t max_bytes_;
+  base::LRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      images_;
+  size_t total_bytes_ = 0;
+  // <image file being read, callbacks waiting for it>
+  base::flat_map<base::FilePath, std::vector<GetImageCallback>> pending_reads_;
+  size_t disk_read_count_ = 0;
+  base::WeakPtrFactory<NTPImageCache> weak_factory_{this};
+};
+
+}  // namespace ntp_background_images
+
+#endif  // BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGE_CACHE_H_
@@ -0,0 +1,181 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/logging.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/timer/elapsed_timer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ntp_background_images {
+
+class NTPImageCacheTest : public testing::Test {
+ public:
+  NTPImageCacheTest() = default;
+  ~NTPImageCacheTest() override = default;
+
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath WriteImage(const std::string& name, size_t size) {
+    const base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+    const std::string contents(size, name[0]);
+    EXPECT_TRUE(base::WriteFile(path, contents));
+    return path;
+  }
+
+  // Waits for the image if it isn't in memory.
+  scoped_refptr<base::RefCountedMemory> GetImage(NTPImageCache* cache,
+                                                 const base::FilePath& path) {
+    scoped_refptr<base::RefCountedMemory> image;
+    base::RunLoop run_loop;
+    cache->GetImage(path, base::BindLambdaForTesting(
+                              [&](scoped_refptr<base::RefCountedMemory> data) {
+                                image = data;
+                                run_loop.Quit();
+                              }));
+    if (!image)
+      run_loop.Run();
+    return image;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(NTPImageCacheTest, ServesFromMemory) {
+  NTPImageCache cache;
+  const base::FilePath path = WriteImage("a.jpg", 1000);
+
+  auto image = GetImage(&cache, path);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->size(), 1000u);
+  EXPECT_EQ(cache.disk_read_count(), 1u);
+
+  // Served synchronously without reading the file again.
+  bool served = false;
+  cache.GetImage(path, base::BindLambdaForTesting(
+                           [&](scoped_refptr<base::RefCountedMemory> data) {
+                             EXPECT_EQ(data, image);
+                             served = true;
+                           }));
+  EXPECT_TRUE(served);
+  EXPECT_EQ(cache.disk_read_count(), 1u);
+}
+
+TEST_F(NTPImageCacheTest, SharesConcurrentReads) {
+  NTPImageCache cache;
+  const base::FilePath path = WriteImage("a.jpg", 1000);
+
+  cache.Prefetch(path);
+  size_t served = 0;
+  for (int i = 0; i < 3; ++i) {
+    cache.GetImage(path, base::BindLambdaForTesting(
+                             [&](scoped_refptr<base::RefCountedMemory> data) {
+                               EXPECT_EQ(data->size(), 1000u);
+                               ++served;
+                             }));
+  }
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(served, 3u);
+  EXPECT_EQ(cache.disk_read_count(), 1u);
+}
+
+TEST_F(NTPImageCacheTest, EvictsLeastRecentlyUsed) {
+  NTPImageCache cache(3000);
+  const base::FilePath a = WriteImage("a.jpg", 1000);
+  const base::FilePath b = WriteImage("b.jpg", 1000);
+  const base::FilePath c = WriteImage("c.jpg", 1000);
+  const base::FilePath d = WriteImage("d.jpg", 1000);
+
+  GetImage(&cache, a);
+  GetImage(&cache, b);
+  GetImage(&cache, c);
+  // |a| becomes the most recently used, |b| is evicted for |d|.
+  GetImage(&cache, a);
+  GetImage(&cache, d);
+  EXPECT_EQ(cache.disk_read_count(), 4u);
+  EXPECT_EQ(cache.total_bytes(), 3000u);
+
+  GetImage(&cache, a);
+  GetImage(&cache, c);
+  EXPECT_EQ(cache.disk_read_count(), 4u);
+  GetImage(&cache, b);
+  EXPECT_EQ(cache.disk_read_count(), 5u);
+
+  // Images above the budget are served but not kept.
+  const base::FilePath large = WriteImage("large.jpg", 4000);
+  EXPECT_EQ(GetImage(&cache, large)->size(), 4000u);
+  EXPECT_EQ(cache.total_bytes(), 3000u);
+
+  cache.Clear();
+  EXPECT_EQ(cache.total_bytes(), 0u);
+}
+
+TEST_F(NTPImageCacheTest, MissingFile) {
+  NTPImageCache cache;
+  bool served = false;
+  base::RunLoop run_loop;
+  cache.GetImage(temp_dir_.GetPath().AppendASCII("missing.jpg"),
+                 base::BindLambdaForTesting(
+                     [&](scoped_refptr<base::RefCountedMemory> data) {
+                       EXPECT_FALSE(data);
+                       served = true;
+                       run_loop.Quit();
+                     }));
+  run_loop.Run();
+  EXPECT_TRUE(served);
+  EXPECT_EQ(cache.total_bytes(), 0u);
+}
+
+// Opens 100 new tabs rotating through 5 wallpapers of 2MB, as
+// ViewCounterService does, and compares against reading every wallpaper
+// from disk.
+TEST_F(NTPImageCacheTest, NewTabs) {
+  constexpr size_t kWallpaperCount = 5;
+  constexpr size_t kWallpaperSize = 2 * 1024 * 1024;
+  constexpr size_t kNewTabCount = 100;
+  std::vector<base::FilePath> wallpapers;
+  for (size_t i = 0; i < kWallpaperCount; ++i) {
+    wallpapers.push_back(WriteImage(
+        base::StringPrintf("%c.jpg", static_cast<char>('a' + i)),
+        kWallpaperSize));
+  }
+
+  // Budget of 0 keeps nothing in memory, like reading the file every time.
+  NTPImageCache uncached(0);
+  base::ElapsedTimer uncached_timer;
+  for (size_t tab = 0; tab < kNewTabCount; ++tab)
+    GetImage(&uncached, wallpapers[tab % kWallpaperCount]);
+  const base::TimeDelta uncached_time = uncached_timer.Elapsed();
+
+  NTPImageCache cache;
+  base::ElapsedTimer cached_timer;
+  for (size_t tab = 0; tab < kNewTabCount; ++tab) {
+    cache.Prefetch(wallpapers[(tab + 1) % kWallpaperCount]);
+    EXPECT_EQ(GetImage(&cache, wallpapers[tab % kWallpaperCount])->size(),
+              kWallpaperSize);
+  }
+  const base::TimeDelta cached_time = cached_timer.Elapsed();
+
+  VLOG(1) << "Per " << kNewTabCount << " new tabs, uncached: "
+          << uncached.disk_read_count() << " disk reads, "
+          << uncached_time / kNewTabCount << " per image; cached: "
+          << cache.disk_read_count() << " disk reads, "
+          << cached_time / kNewTabCount << " per image";
+
+  EXPECT_EQ(uncached.disk_read_count(), kNewTabCount);
+  EXPECT_EQ(cache.disk_read_count(), kWallpaperCount);
+}
+
+}  // namespace ntp_background_images
@@ -10,11 +10,9 @@
 
 #include "base/bind.h"
 #include "base/files/file_path.h"
-#include "base/files/file_util.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
-#include "base/task/thread_pool.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "brave/components/ntp_background_images/browser/ntp_sponsored_images_data.h"
 #include "brave/components/ntp_background_images/browser/url_constants.h"
@@ -25,13 +23,6 @@ namespace ntp_background_images {
 
 namespace {
 
-absl::optional<std::string> ReadFileToString(const base::FilePath& path) {
-  std::string contents;
-  if (!base::ReadFileToString(path, &contents))
-    return absl::optional<std::string>();
-  return contents;
-}
-
 bool IsSuperReferralPath(const std::string& path) {
   return path.rfind(kSuperReferralPath, 0) == 0;
 }
@@ -40,7 +31,7 @@ bool IsSuperReferralPath(const std::string& path) {
 
 NTPSponsoredImagesSource::NTPSponsoredImagesSource(
     NTPBackgroundImagesService* service)
-    : service_(service), weak_factory_(this) {}
+    : service_(service) {}
 
 NTPSponsoredImagesSource::~NTPSponsoredImagesSource() = default;
 
@@ -77,23 +68,7 @@ void NTPSponsoredImagesSource::StartDataRequest(
 void NTPSponsoredImagesSource::GetImageFile(
     const base::FilePath& image_file_path,
     GotDataCallback callback) {
-  base::ThreadPool::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&ReadFileToString, image_file_path),
-      base::BindOnce(&NTPSponsoredImagesSource::OnGotImageFile,
-                     weak_factory_.GetWeakPtr(), std::move(callback)));
-}
-
-void NTPSponsoredImagesSource::OnGotImageFile(
-    GotDataCallback callback,
-    absl::optional<std::string> input) {
-  if (!input)
-    return;
-
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-      reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
-  std::move(callback).Run(std::move(bytes));
+  service_->image_cache()->GetImage(image_file_path, std::move(callback));
 }
 
 std::string NTPSponsoredImagesSource::GetMimeType(const std::string& path) {
@@ -266,6 +266,49 @@ void ViewCounterService::RegisterPageView() {
   // This will be no-op when component is not ready.
   service_->CheckNTPSIComponentUpdateIfNeeded();
   model_.RegisterPageView();
+#if !BUILDFLAG(IS_ANDROID)
+  PrefetchWallpapers();
+#endif
+}
+
+void ViewCounterService::PrefetchWallpapers() {
+  NTPImageCache* image_cache = service_->image_cache();
+
+  // The page view just registered is about to request these, start reading
+  // them while the page loads.
+  if (ShouldShowBrandedWallpaper()) {
+    size_t current_campaign_index;
+    size_t current_background_index;
+    std::tie(current_campaign_index, current_background_index) =
+        model_.GetCurrentBrandedImageIndex();
+    const auto& campaigns = GetCurrentBrandedWallpaperData()->campaigns;
+    if (current_campaign_index < campaigns.size() &&
+        current_background_index <
+            campaigns[current_campaign_index].backgrounds.size()) {
+      const auto& background =
+          campaigns[current_campaign_index]
+              .backgrounds[current_background_index];
+      image_cache->Prefetch(background.image_file);
+      image_cache->Prefetch(background.logo.image_file);
+    }
+  }
+
+  if (!IsBackgroundWallpaperActive())
+    return;
+#if BUILDFLAG(ENABLE_CUSTOM_BACKGROUND)
+  if (custom_bi_service_ && custom_bi_service_->ShouldShowCustomBackground())
+    return;
+#endif
+
+  // The current background image, and the one the rotation selects next.
+  const auto& backgrounds = GetCurrentWallpaperData()->backgrounds;
+  if (backgrounds.empty())
+    return;
+  const size_t index = model_.current_wallpaper_image_index();
+  if (!ShouldShowBrandedWallpaper())
+    image_cache->Prefetch(backgrounds[index % backgrounds.size()].image_file);
+  image_cache->Prefetch(
+      backgrounds[(index + 1) % backgrounds.size()].image_file);
 }
 
 void ViewCounterService::BrandedWallpaperLogoClicked(
@@ -141,6 +141,8 @@ class ViewCounterService : public KeyedService,
   bool ShouldShowBrandedWallpaper() const;
 
   void ResetModel();
+  // Loads the wallpapers of the current and the next page views in memory.
+  void PrefetchWallpapers();
 
   void UpdateP3AValues() const;
 
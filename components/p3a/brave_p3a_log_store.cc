@@ -51,32 +51,52 @@ void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
 
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
-  LogEntry& entry = log_[histogram_name];
-  entry.value = value;
-  if (!entry.sent) {
-    DCHECK(entry.sent_timestamp.is_null());
-    unsent_entries_.insert(histogram_name);
-  }
+  UpdateValues({{histogram_name, value}});
+}
+
+void BraveP3ALogStore::UpdateValues(
+    const base::flat_map<std::string, uint64_t>& values) {
+  if (values.empty())
+    return;
 
-  // Update the persistent value.
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  for (const auto& [histogram_name, value] : values) {
+    LogEntry& entry = log_[histogram_name];
+    entry.value = value;
+    if (!entry.sent) {
+      DCHECK(entry.sent_timestamp.is_null());
+      unsent_entries_.insert(histogram_name);
+    }
+
+    // Update the persistent value.
+    update->SetPath({histogram_name, kLogValueKey},
+                    base::Value(base::NumberToString(value)));
+    update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  }
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
-  DCHECK(delegate_->IsActualMetric(histogram_name));
-  log_.erase(histogram_name);
-  unsent_entries_.erase(histogram_name);
+  RemoveValuesIfExist({histogram_name});
+}
+
+void BraveP3ALogStore::RemoveValuesIfExist(
+    const std::vector<std::string>& histogram_names) {
+  if (histogram_names.empty())
+    return;
 
-  // Update the persistent value.
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->RemovePath(histogram_name);
+  for (const std::string& histogram_name : histogram_names) {
+    DCHECK(delegate_->IsActualMetric(histogram_name));
+    log_.erase(histogram_name);
+    unsent_entries_.erase(histogram_name);
+
+    // Update the persistent value.
+    update->RemovePath(histogram_name);
 
-  if (has_staged_log() && staged_entry_key_ == histogram_name) {
-    staged_entry_key_.clear();
-    staged_log_.clear();
+    if (has_staged_log() && staged_entry_key_ == histogram_name) {
+      staged_entry_key_.clear();
+      staged_log_.clear();
+    }
   }
 }
 
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
@@ -54,8 +55,13 @@ class BraveP3ALogStore : public metrics::LogStore {
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
   void UpdateValue(const std::string& histogram_name, uint64_t value);
+  // Same as |UpdateValue| for several metrics with a single pref update.
+  void UpdateValues(const base::flat_map<std::string, uint64_t>& values);
   // Removes and also unstages the metric value if it is known and/or staged.
   void RemoveValueIfExists(const std::string& histogram_name);
+  // Same as |RemoveValueIfExists| for several metrics with a single pref
+  // update.
+  void RemoveValuesIfExist(const std::vector<std::string>& histogram_names);
   // Marks all saved values as unsent.
   void ResetUploadStamps();
 
@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/i18n/timezone.h"
@@ -47,7 +48,6 @@ namespace {
 // Receiving this value will effectively prevent the metric from transmission
 // to the backend. For now we consider this as a hack for p2a metrics, which
 // should be refactored in better times.
-constexpr int32_t kSuspendedMetricValue = INT_MAX - 1;
 constexpr uint64_t kSuspendedMetricBucket = INT_MAX - 1;
 
 constexpr char kLastRotationTimeStampPref[] = "p3a.last_rotation_timestamp";
@@ -60,6 +60,9 @@ constexpr char kP2AJsonServerUrl[] = "https://p2a-json.brave.com/";
 
 constexpr uint64_t kDefaultUploadIntervalSeconds = 60;  // 1 minute.
 
+// Histogram changes are moved to the log store at most once per interval.
+constexpr base::TimeDelta kHistogramFlushDelay = base::Seconds(1);
+
 // TODO(iefremov): Provide moar histograms!
 // Whitelist for histograms that we collect. Will be replaced with something
 // updating on the fly.
@@ -267,9 +270,7 @@ void BraveP3AService::Init(
   log_store_.reset(new BraveP3ALogStore(this, local_state_));
   log_store_->LoadPersistedUnsentLogs();
   // Store values that were recorded between calling constructor and |Init()|.
-  for (const auto& entry : histogram_values_) {
-    HandleHistogramChange(std::string(entry.first), entry.second);
-  }
+  HandleHistogramChanges(histogram_values_);
   histogram_values_ = {};
   // Do rotation if needed.
   const base::Time last_rotation =
@@ -340,6 +341,10 @@ BraveP3AService::IsActualMetric(base::StringPiece histogram_name) const {
   return metric_names->contains(histogram_name);
 }
 
+void BraveP3AService::OnShutdown() {
+  FlushPendingHistogramValues();
+}
+
 void BraveP3AService::MaybeOverrideSettingsFromCommandLine() {
   base::CommandLine* cmdline = base::CommandLine::ForCurrentProcess();
 
@@ -448,68 +453,79 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
   if (samples->Iterator()->Done())
     return;
 
-  // Shortcut for the special values, see |kSuspendedMetricValue|
+  // Shortcut for the special values, see |kSuspendedMetricBucket|
   // description for details.
-  if (IsSuspendedMetric(histogram_name, sample)) {
-    base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                   base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI,
-                                  this,
-                                  histogram_name,
-                                  kSuspendedMetricValue,
-                                  kSuspendedMetricBucket));
-    return;
-  }
+  size_t bucket = kSuspendedMetricBucket;
+  if (!IsSuspendedMetric(histogram_name, sample)) {
+    // Note that we store only buckets, not actual values.
+    const bool ok = samples->Iterator()->GetBucketIndex(&bucket);
+    if (!ok) {
+      LOG(ERROR) << "Only linear histograms are supported at the moment!";
+      NOTREACHED();
+      return;
+    }
 
-  // Note that we store only buckets, not actual values.
-  size_t bucket = 0u;
-  const bool ok = samples->Iterator()->GetBucketIndex(&bucket);
-  if (!ok) {
-    LOG(ERROR) << "Only linear histograms are supported at the moment!";
-    NOTREACHED();
-    return;
+    // Special handling of P2A histograms.
+    if (base::StartsWith(histogram_name, "Brave.P2A.",
+                         base::CompareCase::SENSITIVE)) {
+      // We need the bucket count to make proper perturbation.
+      // All P2A metrics should be implemented as linear histograms.
+      base::SampleVector* vector =
+          static_cast<base::SampleVector*>(samples.get());
+      DCHECK(vector);
+      const size_t bucket_count = vector->bucket_ranges()->bucket_count() - 1;
+      VLOG(2) << "P2A metric " << histogram_name << " has bucket count "
+              << bucket_count;
+
+      // Perturb the bucket.
+      bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
+    }
   }
 
-  // Special handling of P2A histograms.
-  if (base::StartsWith(histogram_name, "Brave.P2A.",
-                       base::CompareCase::SENSITIVE)) {
-    // We need the bucket count to make proper perturbation.
-    // All P2A metrics should be implemented as linear histograms.
-    base::SampleVector* vector =
-        static_cast<base::SampleVector*>(samples.get());
-    DCHECK(vector);
-    const size_t bucket_count = vector->bucket_ranges()->bucket_count() - 1;
-    VLOG(2) << "P2A metric " << histogram_name << " has bucket count "
-            << bucket_count;
-
-    // Perturb the bucket.
-    bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
+  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
+          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
+  {
+    base::AutoLock lock(pending_values_lock_);
+    pending_values_[histogram_name] = bucket;
+    if (flush_scheduled_)
+      return;
+    flush_scheduled_ = true;
   }
-
-  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
+  base::PostDelayedTask(
+      FROM_HERE, {content::BrowserThread::UI},
+      base::BindOnce(&BraveP3AService::FlushPendingHistogramValues, this),
+      kHistogramFlushDelay);
 }
 
-void BraveP3AService::OnHistogramChangedOnUI(const char* histogram_name,
-                                             base::HistogramBase::Sample sample,
-                                             size_t bucket) {
-  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
-          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
+void BraveP3AService::FlushPendingHistogramValues() {
+  base::flat_map<base::StringPiece, size_t> values;
+  {
+    base::AutoLock lock(pending_values_lock_);
+    values.swap(pending_values_);
+    flush_scheduled_ = false;
+  }
   if (!initialized_) {
     // Will handle it later when ready.
-    histogram_values_[histogram_name] = bucket;
-  } else {
-    HandleHistogramChange(histogram_name, bucket);
+    for (const auto& entry : values)
+      histogram_values_[entry.first] = entry.second;
+    return;
   }
+  HandleHistogramChanges(values);
 }
 
-void BraveP3AService::HandleHistogramChange(base::StringPiece histogram_name,
-                                            size_t bucket) {
-  if (IsSuspendedMetric(histogram_name, bucket)) {
-    log_store_->RemoveValueIfExists(std::string(histogram_name));
-    return;
+void BraveP3AService::HandleHistogramChanges(
+    const base::flat_map<base::StringPiece, size_t>& values) {
+  std::vector<std::string> removed;
+  base::flat_map<std::string, uint64_t> updated;
+  for (const auto& entry : values) {
+    if (IsSuspendedMetric(entry.first, entry.second)) {
+      removed.emplace_back(entry.first);
+    } else {
+      updated.emplace(std::string(entry.first), entry.second);
+    }
   }
-  log_store_->UpdateValue(std::string(histogram_name), bucket);
+  log_store_->RemoveValuesIfExist(removed);
+  log_store_->UpdateValues(updated);
 }
 
 void BraveP3AService::OnLogUploadComplete(int response_code,
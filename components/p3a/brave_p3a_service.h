@@ -14,6 +14,9 @@
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
 #include "base/metrics/statistics_recorder.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
 #include "base/timer/wall_clock_timer.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
 #include "brave/components/p3a/p3a_message.h"
@@ -55,6 +58,10 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void Init(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Moves histogram changes still waiting for the delayed flush to the log
+  // store, so that local state is written with them on shutdown.
+  void OnShutdown();
+
   // BraveP3ALogStore::Delegate
   BraveP3ALogStore::LogForJsonMigration Serialize(
       base::StringPiece histogram_name,
@@ -77,17 +84,18 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void StartScheduledUpload();
 
   // Invoked by callbacks registered by our service. Since these callbacks
-  // can fire on any thread, this method reposts everything to UI thread.
+  // can fire on any thread, this method only records the new bucket and
+  // schedules a flush on UI thread if none is pending.
   void OnHistogramChanged(const char* histogram_name,
                           uint64_t name_hash,
                           base::HistogramBase::Sample sample);
 
-  void OnHistogramChangedOnUI(const char* histogram_name,
-                              base::HistogramBase::Sample sample,
-                              size_t bucket);
+  // Moves the buckets recorded since the last flush to the log store.
+  void FlushPendingHistogramValues();
 
-  // Updates or removes a metric from the log.
-  void HandleHistogramChange(base::StringPiece histogram_name, size_t bucket);
+  // Updates or removes metrics from the log.
+  void HandleHistogramChanges(
+      const base::flat_map<base::StringPiece, size_t>& values);
 
   void OnLogUploadComplete(int response_code, int error_code, bool was_https);
 
@@ -123,6 +131,14 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // the service and its initialization.
   base::flat_map<base::StringPiece, size_t> histogram_values_;
 
+  // Latest bucket of each histogram changed since the last flush. Only the
+  // latest bucket matters, so a burst of samples ends up as a single UI task
+  // and a single pref update.
+  base::Lock pending_values_lock_;
+  base::flat_map<base::StringPiece, size_t> pending_values_
+      GUARDED_BY(pending_values_lock_);
+  bool flush_scheduled_ GUARDED_BY(pending_values_lock_) = false;
+
   // Once fired we restart the overall uploading process.
   base::WallClockTimer rotation_timer_;
 
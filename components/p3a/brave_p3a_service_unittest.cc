@@ -0,0 +1,148 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_service.h"
+
+#include <limits.h>
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/brave_referrals/common/pref_names.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "components/prefs/testing_pref_service.h"
+#include "content/public/test/browser_task_environment.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveP3AServiceTest*
+
+namespace brave {
+
+namespace {
+
+constexpr char kLogsPref[] = "p3a.logs";
+
+}  // namespace
+
+class BraveP3AServiceTest : public testing::Test {
+ public:
+  BraveP3AServiceTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        statistics_recorder_(
+            base::StatisticsRecorder::CreateTemporaryForTesting()) {}
+  ~BraveP3AServiceTest() override = default;
+
+  void SetUp() override {
+    BraveP3AService::RegisterPrefs(local_state_.registry(), true);
+    local_state_.registry()->RegisterStringPref(kReferralPromoCode,
+                                                std::string());
+    service_ = base::MakeRefCounted<BraveP3AService>(&local_state_, "release",
+                                                     "2022-01-03");
+    service_->InitCallbacks();
+    service_->Init(
+        base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+            &url_loader_factory_));
+    task_environment_.RunUntilIdle();
+
+    pref_change_registrar_.Init(&local_state_);
+    pref_change_registrar_.Add(
+        kLogsPref, base::BindRepeating([](size_t* count) { ++*count; },
+                                       &logs_pref_writes_));
+  }
+
+  void TearDown() override {
+    pref_change_registrar_.RemoveAll();
+    service_.reset();
+  }
+
+  const base::Value* GetLoggedValue(const std::string& histogram_name) {
+    const base::Value* entry =
+        local_state_.GetDictionary(kLogsPref)->FindDictKey(histogram_name);
+    return entry ? entry->FindKey("value") : nullptr;
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<base::StatisticsRecorder> statistics_recorder_;
+  TestingPrefServiceSimple local_state_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  PrefChangeRegistrar pref_change_registrar_;
+  size_t logs_pref_writes_ = 0;
+  scoped_refptr<BraveP3AService> service_;
+};
+
+TEST_F(BraveP3AServiceTest, FlushesLatestBucket) {
+  base::UmaHistogramExactLinear("Brave.Core.TabCount", 2, 7);
+  base::UmaHistogramExactLinear("Brave.Core.TabCount", 5, 7);
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(GetLoggedValue("Brave.Core.TabCount"));
+
+  task_environment_.FastForwardBy(base::Seconds(1));
+  const base::Value* value = GetLoggedValue("Brave.Core.TabCount");
+  ASSERT_TRUE(value);
+  EXPECT_EQ(value->GetString(), "5");
+  EXPECT_EQ(logs_pref_writes_, 1u);
+}
+
+TEST_F(BraveP3AServiceTest, SuspendedMetricIsRemoved) {
+  base::UmaHistogramExactLinear("Brave.P2A.TotalAdOpportunities", 1, 7);
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_TRUE(GetLoggedValue("Brave.P2A.TotalAdOpportunities"));
+
+  // As ads do to suspend P2A metrics.
+  base::UmaHistogramExactLinear("Brave.P2A.TotalAdOpportunities", INT_MAX, 7);
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_FALSE(GetLoggedValue("Brave.P2A.TotalAdOpportunities"));
+}
+
+TEST_F(BraveP3AServiceTest, FlushesOnShutdown) {
+  base::UmaHistogramExactLinear("Brave.Core.TabCount", 3, 7);
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(GetLoggedValue("Brave.Core.TabCount"));
+
+  service_->OnShutdown();
+  const base::Value* value = GetLoggedValue("Brave.Core.TabCount");
+  ASSERT_TRUE(value);
+  EXPECT_EQ(value->GetString(), "3");
+
+  // The delayed flush has nothing left to write.
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_EQ(logs_pref_writes_, 1u);
+}
+
+// Records a burst of 10k samples over a few histograms and counts the UI
+// tasks and log pref writes it takes to get them to the log store.
+TEST_F(BraveP3AServiceTest, BurstOfSamples) {
+  constexpr int kSampleCount = 10000;
+  const char* kHistograms[] = {"Brave.Core.TabCount",
+                               "Brave.Core.WindowCount.2",
+                               "Brave.Omnibox.SearchCount"};
+
+  const size_t pending_tasks =
+      task_environment_.GetPendingMainThreadTaskCount();
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kSampleCount; ++i)
+    base::UmaHistogramExactLinear(kHistograms[i % 3], i % 7, 7);
+  task_environment_.RunUntilIdle();
+  const size_t ui_tasks =
+      task_environment_.GetPendingMainThreadTaskCount() - pending_tasks;
+  task_environment_.FastForwardBy(base::Seconds(1));
+
+  VLOG(1) << kSampleCount << " samples took " << timer.Elapsed() << ", "
+          << ui_tasks << " UI tasks and " << logs_pref_writes_
+          << " pref writes";
+  EXPECT_EQ(ui_tasks, 1u);
+  EXPECT_EQ(logs_pref_writes_, 1u);
+  for (const char* histogram_name : kHistograms)
+    EXPECT_TRUE(GetLoggedValue(histogram_name));
+}
+
+}  // namespace brave
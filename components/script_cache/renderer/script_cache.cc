@@ -0,0 +1,92 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/script_cache/renderer/script_cache.h"
+
+#include <map>
+
+#include "base/check_op.h"
+#include "base/no_destructor.h"
+#include "gin/converter.h"
+#include "third_party/blink/public/web/blink.h"
+#include "third_party/blink/public/web/web_local_frame.h"
+#include "v8/include/v8-function.h"
+#include "v8/include/v8-isolate.h"
+#include "v8/include/v8-microtask-queue.h"
+#include "v8/include/v8-persistent-handle.h"
+#include "v8/include/v8-script.h"
+
+namespace script_cache {
+
+namespace {
+
+using CompiledScripts = std::map<std::string, v8::Eternal<v8::UnboundScript>>;
+
+// Eternal handles belong to the isolate that created them, so every isolate
+// has its own scripts. The main thread isolate lives as long as the renderer,
+// its scripts are never dropped.
+CompiledScripts& GetCompiledScripts(v8::Isolate* isolate) {
+  static base::NoDestructor<std::map<v8::Isolate*, CompiledScripts>>
+      compiled_scripts;
+  return (*compiled_scripts)[isolate];
+}
+
+v8::MaybeLocal<v8::UnboundScript> GetCompiledScript(v8::Isolate* isolate,
+                                                    const std::string& name,
+                                                    const std::string& script) {
+  CompiledScripts& compiled_scripts = GetCompiledScripts(isolate);
+  auto it = compiled_scripts.find(name);
+  if (it != compiled_scripts.end())
+    return it->second.Get(isolate);
+
+  v8::Local<v8::String> source_str;
+  if (!v8::String::NewFromUtf8(isolate,
+                               ("(function() {" + script + "\n})").c_str(),
+                               v8::NewStringType::kNormal)
+           .ToLocal(&source_str)) {
+    return v8::MaybeLocal<v8::UnboundScript>();
+  }
+  v8::ScriptOrigin origin(isolate, gin::StringToV8(isolate, name));
+  v8::ScriptCompiler::Source source(source_str, origin);
+  v8::Local<v8::UnboundScript> unbound_script;
+  if (!v8::ScriptCompiler::CompileUnboundScript(isolate, &source)
+           .ToLocal(&unbound_script)) {
+    return v8::MaybeLocal<v8::UnboundScript>();
+  }
+
+  compiled_scripts.emplace(
+      name, v8::Eternal<v8::UnboundScript>(isolate, unbound_script));
+  return unbound_script;
+}
+
+}  // namespace
+
+bool RunCachedScript(blink::WebLocalFrame* web_frame,
+                     v8::Local<v8::Context> context,
+                     const std::string& name,
+                     const std::string& script) {
+  v8::Isolate* isolate = context->GetIsolate();
+  DCHECK_EQ(isolate, blink::MainThreadIsolate());
+
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(context);
+  v8::MicrotasksScope microtasks(isolate,
+                                 v8::MicrotasksScope::kDoNotRunMicrotasks);
+
+  v8::Local<v8::UnboundScript> unbound_script;
+  v8::Local<v8::Value> function;
+  if (!GetCompiledScript(isolate, name, script).ToLocal(&unbound_script) ||
+      !unbound_script->BindToCurrentContext()->Run(context).ToLocal(
+          &function) ||
+      !function->IsFunction()) {
+    return false;
+  }
+
+  web_frame->CallFunctionEvenIfScriptDisabled(function.As<v8::Function>(),
+                                              context->Global(), 0, nullptr);
+  return true;
+}
+
+}  // namespace script_cache
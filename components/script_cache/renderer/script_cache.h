@@ -0,0 +1,43 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SCRIPT_CACHE_RENDERER_SCRIPT_CACHE_H_
+#define BRAVE_COMPONENTS_SCRIPT_CACHE_RENDERER_SCRIPT_CACHE_H_
+
+#include <string>
+
+#include "v8/include/v8-context.h"
+#include "v8/include/v8-local-handle.h"
+
+namespace blink {
+class WebLocalFrame;
+}  // namespace blink
+
+namespace script_cache {
+
+// Runs |script| in |context|, a script context of |web_frame|. |script| is
+// compiled once per isolate as the body of a function and kept under |name|,
+// which is also the script's URL in DevTools. Later calls with the same
+// |name| bind the compiled function to their context instead of compiling
+// |script| again. Only the renderer main thread isolate may be used.
+//
+// As a function body, the top-level var, let, const and function
+// declarations of |script| are local to it and don't become globals of
+// |context|. Webpack bundles have none: their output is a single function
+// expression that publishes its state through |window|.
+//
+// The function is called even if script is disabled in |web_frame|. Callers
+// that run in the main world must check the content settings first.
+//
+// Returns false if |script| couldn't be compiled or bound to |context|. The
+// caller should then execute it as a classic script.
+bool RunCachedScript(blink::WebLocalFrame* web_frame,
+                     v8::Local<v8::Context> context,
+                     const std::string& name,
+                     const std::string& script);
+
+}  // namespace script_cache
+
+#endif  // BRAVE_COMPONENTS_SCRIPT_CACHE_RENDERER_SCRIPT_CACHE_H_
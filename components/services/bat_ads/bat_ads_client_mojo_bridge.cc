@@ -319,6 +319,15 @@ void BatAdsClientMojoBridge::OnAdRewardsChanged() {
   bat_ads_client_->OnAdRewardsChanged();
 }
 
+void BatAdsClientMojoBridge::OnConversionUrlPatternsChanged(
+    const std::vector<std::string>& url_patterns) {
+  if (!connected()) {
+    return;
+  }
+
+  bat_ads_client_->OnConversionUrlPatternsChanged(url_patterns);
+}
+
 void BatAdsClientMojoBridge::Log(
     const char* file,
     const int line,
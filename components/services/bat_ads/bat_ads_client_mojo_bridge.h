@@ -96,6 +96,9 @@ class BatAdsClientMojoBridge
 
   void OnAdRewardsChanged() override;
 
+  void OnConversionUrlPatternsChanged(
+      const std::vector<std::string>& url_patterns) override;
+
   void Log(
       const char* file,
       const int line,
@@ -346,6 +346,11 @@ void AdsClientMojoBridge::OnAdRewardsChanged() {
   ads_client_->OnAdRewardsChanged();
 }
 
+void AdsClientMojoBridge::OnConversionUrlPatternsChanged(
+    const std::vector<std::string>& url_patterns) {
+  ads_client_->OnConversionUrlPatternsChanged(url_patterns);
+}
+
 void AdsClientMojoBridge::GetBooleanPref(
     const std::string& path,
     GetBooleanPrefCallback callback) {
@@ -110,6 +110,8 @@ class AdsClientMojoBridge
   void RunDBTransaction(ads::mojom::DBTransactionPtr transaction,
                         RunDBTransactionCallback callback) override;
   void OnAdRewardsChanged() override;
+  void OnConversionUrlPatternsChanged(
+      const std::vector<std::string>& url_patterns) override;
 
   void GetBooleanPref(
       const std::string& path,
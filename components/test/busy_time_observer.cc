@@ -0,0 +1,32 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/test/busy_time_observer.h"
+
+#include "base/pending_task.h"
+#include "base/task/current_thread.h"
+
+BusyTimeObserver::BusyTimeObserver() {
+  base::CurrentThread::Get()->AddTaskObserver(this);
+}
+
+BusyTimeObserver::~BusyTimeObserver() {
+  base::CurrentThread::Get()->RemoveTaskObserver(this);
+}
+
+base::TimeDelta BusyTimeObserver::TakeBusyTime() {
+  base::TimeDelta busy_time = busy_time_;
+  busy_time_ = base::TimeDelta();
+  return busy_time;
+}
+
+void BusyTimeObserver::WillProcessTask(const base::PendingTask& pending_task,
+                                       bool was_blocked_or_low_priority) {
+  task_start_ = base::TimeTicks::Now();
+}
+
+void BusyTimeObserver::DidProcessTask(const base::PendingTask& pending_task) {
+  busy_time_ += base::TimeTicks::Now() - task_start_;
+}
@@ -0,0 +1,34 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_TEST_BUSY_TIME_OBSERVER_H_
+#define BRAVE_COMPONENTS_TEST_BUSY_TIME_OBSERVER_H_
+
+#include "base/task/task_observer.h"
+#include "base/time/time.h"
+
+// Adds up the time spent running tasks on the thread it is created on, e.g.
+// to compare how long the UI thread is kept busy by two implementations.
+class BusyTimeObserver : public base::TaskObserver {
+ public:
+  BusyTimeObserver();
+  BusyTimeObserver(const BusyTimeObserver&) = delete;
+  BusyTimeObserver& operator=(const BusyTimeObserver&) = delete;
+  ~BusyTimeObserver() override;
+
+  // Returns the time accumulated so far and starts over.
+  base::TimeDelta TakeBusyTime();
+
+  // base::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  base::TimeTicks task_start_;
+  base::TimeDelta busy_time_;
+};
+
+#endif  // BRAVE_COMPONENTS_TEST_BUSY_TIME_OBSERVER_H_
@@ -64,6 +64,8 @@ class AdsClientIOS : public ads::AdsClient {
   void RunDBTransaction(ads::mojom::DBTransactionPtr transaction,
                         ads::RunDBTransactionCallback callback) override;
   void OnAdRewardsChanged() override;
+  void OnConversionUrlPatternsChanged(
+      const std::vector<std::string>& url_patterns) override;
   void SetBooleanPref(const std::string& path, const bool value) override;
   bool GetBooleanPref(const std::string& path) const override;
   void SetIntegerPref(const std::string& path, const int value) override;
@@ -135,6 +135,11 @@ void AdsClientIOS::OnAdRewardsChanged() {
   [bridge_ onAdRewardsChanged];
 }
 
+void AdsClientIOS::OnConversionUrlPatternsChanged(
+    const std::vector<std::string>& url_patterns) {
+  // iOS passes the HTML of every page to the ads library.
+}
+
 void AdsClientIOS::SetBooleanPref(const std::string& path, const bool value) {
   [bridge_ setBooleanPref:path value:value];
 }
@@ -3,25 +3,63 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
 #include "base/path_service.h"
+#include "base/run_loop.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/test/trace_event_analyzer.h"
+#include "base/trace_event/trace_config.h"
 #include "brave/common/brave_paths.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
+#include "brave/components/brave_wallet/resources/grit/brave_wallet_script_generated.h"
+#include "brave/components/cosmetic_filters/resources/grit/cosmetic_filters_generated_map.h"
 #include "build/build_config.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/ui/browser.h"
 #include "chrome/browser/ui/browser_commands.h"
 #include "chrome/browser/ui/tabs/tab_strip_model.h"
 #include "chrome/common/chrome_isolated_world_ids.h"
 #include "chrome/test/base/in_process_browser_test.h"
 #include "chrome/test/base/ui_test_utils.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/tracing_controller.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
 #include "net/dns/mock_host_resolver.h"
 #include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
+#include "ui/base/resource/resource_bundle.h"
 #include "url/gurl.h"
 
 namespace {
+
+constexpr size_t kIframeCount = 50;
+
+std::unique_ptr<net::test_server::HttpResponse> HandleIframesRequest(
+    const net::test_server::HttpRequest& request) {
+  if (request.relative_url != "/iframes.html")
+    return nullptr;
+
+  std::string content = "<html><body>";
+  for (size_t i = 0; i < kIframeCount; ++i)
+    content += "<iframe src=\"/simple.html\"></iframe>";
+  content += "</body></html>";
+
+  auto http_response = std::make_unique<net::test_server::BasicHttpResponse>();
+  http_response->set_code(net::HTTP_OK);
+  http_response->set_content_type("text/html");
+  http_response->set_content(content);
+  return http_response;
+}
+
 std::string NonWriteableScript(const std::string& method,
                                const std::string& args) {
   return base::StringPrintf(
@@ -32,6 +70,35 @@ std::string NonWriteableScript(const std::string& method,
            window.domAutomationController.send(true))",
       method.c_str(), method.c_str(), args.c_str());
 }
+
+// Evaluates to the names of the globals |source| declares with a top-level
+// var or function when it runs as a classic script, but not when it runs as
+// the body of a function the way script_cache::RunCachedScript runs it.
+// Declarations are instantiated before the script runs, so a script that
+// throws in a blank frame is still checked.
+constexpr char kGlobalDeclarationsScript[] = R"(
+  (() => {
+    const source = $1;
+    const addedGlobals = (run) => {
+      const frame = document.createElement('iframe');
+      document.body.appendChild(frame);
+      const before = new Set(Object.getOwnPropertyNames(frame.contentWindow));
+      try {
+        run(frame.contentWindow);
+      } catch (e) {}
+      const added = Object.getOwnPropertyNames(frame.contentWindow)
+          .filter(name => !before.has(name));
+      frame.remove();
+      return added;
+    };
+    const asFunction = new Set(addedGlobals(w => w.Function(source)()));
+    return addedGlobals(w => w.eval(source))
+        .filter(name => !asFunction.has(name)).sort().join(',');
+  })())";
+
+std::string GetGlobalDeclarationsScript(const std::string& source) {
+  return content::JsReplace(kGlobalDeclarationsScript, source);
+}
 }  // namespace
 
 class JSEthereumProviderBrowserTest : public InProcessBrowserTest {
@@ -43,6 +110,8 @@ class JSEthereumProviderBrowserTest : public InProcessBrowserTest {
     base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
     https_server_.SetSSLConfig(net::EmbeddedTestServer::CERT_OK);
     https_server_.ServeFilesFromDirectory(test_data_dir);
+    https_server_.RegisterRequestHandler(
+        base::BindRepeating(&HandleIframesRequest));
   }
 
   ~JSEthereumProviderBrowserTest() override = default;
@@ -160,3 +229,100 @@ IN_PROC_BROWSER_TEST_F(JSEthereumProviderBrowserTest, NonWritable) {
              content::EXECUTE_SCRIPT_USE_MANUAL_REPLY);
   EXPECT_EQ(base::Value(true), result4.value);
 }
+
+IN_PROC_BROWSER_TEST_F(JSEthereumProviderBrowserTest,
+                       NoProviderScriptWhenScriptBlocked) {
+  brave_wallet::SetDefaultWallet(
+      browser()->profile()->GetPrefs(),
+      brave_wallet::mojom::DefaultWallet::BraveWallet);
+  const GURL url = https_server_.GetURL("/simple.html");
+  HostContentSettingsMapFactory::GetForProfile(browser()->profile())
+      ->SetContentSettingDefaultScope(url, GURL(),
+                                      ContentSettingsType::JAVASCRIPT,
+                                      CONTENT_SETTING_BLOCK);
+  NavigateToURLAndWaitForLoadStop(url);
+  // EvalJs still runs in the main world while script is blocked.
+  const std::string command =
+      "!!(window.ethereum && window.ethereum.isMetaMask)";
+  EXPECT_EQ(false, content::EvalJs(main_frame(), command));
+
+  HostContentSettingsMapFactory::GetForProfile(browser()->profile())
+      ->SetContentSettingDefaultScope(url, GURL(),
+                                      ContentSettingsType::JAVASCRIPT,
+                                      CONTENT_SETTING_ALLOW);
+  ReloadAndWaitForLoadStop();
+  EXPECT_EQ(true, content::EvalJs(main_frame(), command));
+}
+
+// Injects the provider into a page with many iframes, compiling the provider
+// script only for the first frame, and reports the per-frame injection time.
+IN_PROC_BROWSER_TEST_F(JSEthereumProviderBrowserTest, ManyIframes) {
+  brave_wallet::SetDefaultWallet(
+      browser()->profile()->GetPrefs(),
+      brave_wallet::mojom::DefaultWallet::BraveWallet);
+
+  base::RunLoop start_tracing_loop;
+  ASSERT_TRUE(content::TracingController::GetInstance()->StartTracing(
+      base::trace_event::TraceConfig("brave", ""),
+      start_tracing_loop.QuitClosure()));
+  start_tracing_loop.Run();
+
+  NavigateToURLAndWaitForLoadStop(https_server_.GetURL("/iframes.html"));
+
+  size_t frame_count = 0;
+  for (auto* frame : content::CollectAllRenderFrameHosts(web_contents())) {
+    EXPECT_EQ(true, content::EvalJs(frame, "!!window.ethereum.isMetaMask"));
+    ++frame_count;
+  }
+  EXPECT_EQ(frame_count, kIframeCount + 1);
+
+  std::string trace_json;
+  base::RunLoop stop_tracing_loop;
+  ASSERT_TRUE(content::TracingController::GetInstance()->StopTracing(
+      content::TracingController::CreateStringEndpoint(
+          base::BindLambdaForTesting([&](std::unique_ptr<std::string> trace) {
+            trace_json = std::move(*trace);
+            stop_tracing_loop.Quit();
+          }))));
+  stop_tracing_loop.Run();
+
+  std::unique_ptr<trace_analyzer::TraceAnalyzer> analyzer(
+      trace_analyzer::TraceAnalyzer::Create(trace_json));
+  ASSERT_TRUE(analyzer);
+  trace_analyzer::TraceEventVector events;
+  analyzer->FindEvents(
+      trace_analyzer::Query::EventNameIs("InjectEthereumProvider"), &events);
+  ASSERT_GE(events.size(), frame_count);
+  double total_duration = 0;
+  for (const auto* event : events)
+    total_duration += event->duration;
+  VLOG(1) << events.size() << " provider injections for " << frame_count
+          << " frames, " << total_duration / events.size()
+          << " us per injection";
+}
+
+// The bundles run through script_cache::RunCachedScript don't declare
+// globals that the function wrapper would turn into locals.
+IN_PROC_BROWSER_TEST_F(JSEthereumProviderBrowserTest,
+                       CachedBundlesDeclareNoGlobals) {
+  NavigateToURLAndWaitForLoadStop(https_server_.GetURL("/simple.html"));
+
+  // The check itself sees a top-level var.
+  EXPECT_EQ("declared",
+            content::EvalJs(main_frame(),
+                            GetGlobalDeclarationsScript("var declared = 1;")));
+  EXPECT_EQ("", content::EvalJs(main_frame(), GetGlobalDeclarationsScript(
+                                                  "window.assigned = 1;")));
+
+  auto& resource_bundle = ui::ResourceBundle::GetSharedInstance();
+  for (const int id :
+       {IDR_BRAVE_WALLET_SCRIPT_ETHEREUM_PROVIDER_SCRIPT_BUNDLE_JS,
+        IDR_BRAVE_WALLET_SCRIPT_SOLANA_PROVIDER_SCRIPT_BUNDLE_JS,
+        kCosmeticFiltersGenerated[0].id}) {
+    const std::string source = resource_bundle.LoadDataResourceString(id);
+    ASSERT_FALSE(source.empty()) << id;
+    EXPECT_EQ("", content::EvalJs(main_frame(),
+                                  GetGlobalDeclarationsScript(source)))
+        << id;
+  }
+}